@@ -7,14 +7,127 @@
  ============================================================================
  */
 
+#include <avr/interrupt.h>
 #include "lcd.h"
 #include "lm35_sensor.h"
 #include "dc_motor.h"
+#include "fan_tach.h"
 #include "adc.h"
+#include "eeprom.h"
+#include "scheduler.h"
+#include "pid_controller.h"
+#include "fan_curve.h"
+#include "telemetry.h"
+#include "sensor_filter.h"
 
+/* Tasks rates in scheduler ticks, the offsets keep them in different ticks */
+#define APP_SENSOR_TASK_PERIOD			10
+#define APP_CONTROL_TASK_PERIOD			100
+#define APP_CONTROL_TASK_OFFSET			1
+#define APP_DISPLAY_TASK_PERIOD			250
+#define APP_DISPLAY_TASK_OFFSET			2
+#define APP_TELEMETRY_TASK_PERIOD		100
+#define APP_TELEMETRY_TASK_OFFSET		3
+#define APP_CALIBRATION_TASK_PERIOD		10000
+
+/* The first calibration waits for the first bandgap measurement, 5 ADC triggers after the start (10 ms) */
+#define APP_CALIBRATION_TASK_OFFSET		24
+
+/* Fan control: the bands of the fan curve or the PID regulation to the setpoint */
+#define APP_STEPPED_CONTROL				0
+#define APP_PID_CONTROL					1
+
+#define APP_CONTROL_MODE				(APP_PID_CONTROL)
+
+#if(APP_PID_CONTROL == APP_CONTROL_MODE)
+/* Setpoint in deci-degrees, 40.0 C */
+#define APP_TEMPERATURE_SETPOINT_DC		400
+
+/* Full speed at 10.0 C above the setpoint, integral time 60 s with the control task period */
+#define APP_PID_KP						PID_GAIN(255.0 / 100)
+#define APP_PID_KI						PID_GAIN((255.0 / 100) * (APP_CONTROL_TASK_PERIOD * SCHEDULER_TICK_MS) / 60000)
+#define APP_PID_KD						PID_GAIN(0)
+#endif
+
+/* ADC conversions start once per zone 0 PWM period, about 490 conversions per second, so each sensor is sampled
+ * every 4 ms at the same place of the motor switching edges and the oversampled value averages the last 65 ms.
+ * Back to back conversions at 1MHz come faster than the ADC ISR runs, so ADC_TRIGGER_FREE_RUNNING is not used. */
+#define APP_ADC_TRIGGER_SOURCE			(ADC_TRIGGER_TIMER0_OVERFLOW)
+
+/* Weight of the new median in the temperature average, 1/8 with the sensor task period gives 80 ms time constant */
+#define APP_FILTER_EMA_SHIFT			3
+
+/* Zone n has the LM35 sensor n and the DC motor n */
+#define APP_NUM_OF_ZONES				DC_MOTOR_NUM_OF_ZONES
+
+/* A driven fan without tach edges after this time is stalled */
+#define APP_FAN_SPIN_UP_MS				2000
+
+/* Fan state shown on the LCD */
+#define APP_FAN_OFF						0
+#define APP_FAN_ON						1
+#define APP_FAN_STALLED					2
+
+#if (LM35_NUM_OF_SENSORS != DC_MOTOR_NUM_OF_ZONES)
+#error "Each fan zone should have one LM35 sensor"
+#endif
+
+void App_init(void);
+void App_sensorTask(void);
+void App_controlTask(void);
+void App_displayTask(void);
+void App_telemetryTask(void);
+void App_calibrationTask(void);
 void Display_Temperature(uint8 temp);
 
+/* Latest temperature in deci-degrees and fan duty of each zone, shared between the tasks */
+static uint16 g_app_temperature[APP_NUM_OF_ZONES] ;
+static uint8 g_app_duty[APP_NUM_OF_ZONES] ;
+
+/* Spike rejection and smoothing of each zone temperature */
+static Filter_StateType g_app_filter[APP_NUM_OF_ZONES] ;
+
+/* Zone and fan state shown on the LCD, the fan state is written again only when it changes */
+static uint8 g_app_displayedZone = 0 ;
+static uint8 g_app_displayedFanState = 0xFF ;
+
+/* Stall detection of the fan with the tachometer, the last tick it was not driven */
+static uint32 g_app_fanOffTick = 0 ;
+static boolean g_app_fanStalled = FALSE ;
+
+#if(APP_PID_CONTROL == APP_CONTROL_MODE)
+/* All the zones start with the same tuning, each one has its own controller state */
+static const PID_ControllerType g_app_pidConfig =
+	PID_CONTROLLER(APP_PID_KP, APP_PID_KI, APP_PID_KD, APP_TEMPERATURE_SETPOINT_DC, PID_COOLING, 0, PWM_MAXIMUM_DUTY) ;
+
+static PID_ControllerType g_app_pid[APP_NUM_OF_ZONES] ;
+#endif
+
+/* ADC scan of the LM35 inputs, sensor n is the entry n */
+static const ADC_ScanEntryType g_app_adcScanList[] = { LM35_SENSORS(LM35_SCAN_ENTRY) } ;
+
+/* Static tasks table, the first task has the highest priority */
+static Scheduler_TaskType g_app_tasks[] =
+{
+	SCHEDULER_TASK(APP_SENSOR_TASK_PERIOD,      0,                           App_sensorTask),
+	SCHEDULER_TASK(APP_CONTROL_TASK_PERIOD,     APP_CONTROL_TASK_OFFSET,     App_controlTask),
+	SCHEDULER_TASK(APP_DISPLAY_TASK_PERIOD,     APP_DISPLAY_TASK_OFFSET,     App_displayTask),
+	SCHEDULER_TASK(APP_TELEMETRY_TASK_PERIOD,   APP_TELEMETRY_TASK_OFFSET,   App_telemetryTask),
+	SCHEDULER_TASK(APP_CALIBRATION_TASK_PERIOD, APP_CALIBRATION_TASK_OFFSET, App_calibrationTask),
+};
+
 int main()
+{
+	App_init();
+
+	/* Run the tasks, it never returns */
+	Scheduler_run();
+
+	return 0 ;
+}
+
+/* Initialize the drivers, the scheduler and enable the interrupts */
+void App_init(void)
 {
 	/* Initialize LCD driver */
 	LCD_init();
@@ -22,59 +135,186 @@ int main()
 	/* Initialize Motor driver */
 	DcMotor_Init();
 
+	/* Start measuring the fan speed */
+	Fan_TachInit();
+
+	/* Start the telemetry stream on the UART */
+	Telemetry_init();
+
+	uint8 zone ;
+
+	for(zone = 0 ; zone < APP_NUM_OF_ZONES ; zone++)
+	{
+		g_app_filter[zone].ema_shift = APP_FILTER_EMA_SHIFT ;
+		Filter_reset(&g_app_filter[zone]);
+	}
+
+#if(APP_PID_CONTROL == APP_CONTROL_MODE)
+	for(zone = 0 ; zone < APP_NUM_OF_ZONES ; zone++)
+	{
+		g_app_pid[zone] = g_app_pidConfig ;
+		PID_reset(&g_app_pid[zone]);
+	}
+#else
+	FanCurve_init();
+#endif
+
 	ADC_ConfigType ADC_ConfigStruct ;
 	ADC_ConfigStruct.ref_volt = INTERNAL_VOLTAGE ;
-	ADC_ConfigStruct.prescaler = F_CPU_8 ;
+	ADC_ConfigStruct.prescaler = ADC_PRESCALER_AUTO ;
+	ADC_ConfigStruct.mode = ADC_FREE_RUNNING_MODE ;
+	ADC_ConfigStruct.channels_mask = LM35_CHANNELS_MASK ;
+	ADC_ConfigStruct.scan_list = g_app_adcScanList ;
+	ADC_ConfigStruct.scan_length = LM35_NUM_OF_SENSORS ;
+	ADC_ConfigStruct.trigger_source = APP_ADC_TRIGGER_SOURCE ;
 
 	/* Initialize ADC driver */
 	ADC_init(&ADC_ConfigStruct) ;
 
-	uint8 temp = 0 ;
+	/* Start with the reference calibration of the last run, the calibration task measures it again */
+	LM35_Init();
 
-	while(1)
+	/* The calibration task saves the new measurements in the background */
+	EEPROM_init();
+
+	/* Start the 1 ms system tick */
+	Scheduler_init(g_app_tasks, sizeof(g_app_tasks) / sizeof(g_app_tasks[0]));
+
+	/* Enable global interrupts, the ADC ISR samples the sensor in the background */
+	sei();
+}
+
+/* Sample and filter the temperature of all the zones, a noise spike does not reach the fan control */
+void App_sensorTask(void)
+{
+	uint8 zone ;
+
+	for(zone = 0 ; zone < APP_NUM_OF_ZONES ; zone++)
 	{
-		/* Get the temperature value */
-		temp = LM35_GetTemperature();
+		g_app_temperature[zone] = Filter_update(&g_app_filter[zone], LM35_GetTemperature_dC(zone));
+	}
+}
 
-		/* Control the duty cycle of the output PWM signal (Fan Speed) based on the temperature value */
-		if(temp >= 120)
-		{
-			/* Rotates the motor with 100% from its speed */
-			LCD_displayStringRowColumn(0, 4, "FAN is ON ");
-			Display_Temperature(temp);
-			DcMotor_Rotate(MOTOR_CW, 100);
-		}
-		else if(temp >= 90)
-		{
-			/* Rotates the motor with 75% from its speed */
-			LCD_displayStringRowColumn(0, 4, "FAN is ON ");
-			Display_Temperature(temp);
-			DcMotor_Rotate(MOTOR_CW, 75);
-		}
-		else if(temp >= 60)
+/* Control the duty cycle of the output PWM signal (Fan Speed) of each zone based on its temperature value */
+void App_controlTask(void)
+{
+	uint8 zone ;
+#if(APP_STEPPED_CONTROL == APP_CONTROL_MODE)
+	uint8 speed ;
+#endif
+
+	for(zone = 0 ; zone < APP_NUM_OF_ZONES ; zone++)
+	{
+#if(APP_PID_CONTROL == APP_CONTROL_MODE)
+		/* The task period is the PID sample period */
+		g_app_duty[zone] = PID_update(&g_app_pid[zone], (sint16)g_app_temperature[zone]);
+		DcMotor_RotateRaw(zone, (0 == g_app_duty[zone]) ? MOTOR_OFF : MOTOR_CW, g_app_duty[zone]);
+#else
+		/* The motor is updated only when the temperature moves to another band */
+		if(FanCurve_update(zone, g_app_temperature[zone] / 10))
 		{
-			/* Rotates the motor with 50% from its speed */
-			LCD_displayStringRowColumn(0, 4, "FAN is ON ");
-			Display_Temperature(temp);
-			DcMotor_Rotate(MOTOR_CW, 50);
+			speed = FanCurve_getSpeed(zone);
+			g_app_duty[zone] = DC_MOTOR_SPEED_TO_DUTY(speed) ;
+			DcMotor_Rotate(zone, (0 == speed) ? MOTOR_OFF : MOTOR_CW, speed);
 		}
-		else if(temp >= 30)
+		else
 		{
-			/* Rotates the motor with 25% from its speed */
-			LCD_displayStringRowColumn(0, 4, "FAN is ON ");
-			Display_Temperature(temp);
-			DcMotor_Rotate(MOTOR_CW, 25);
+			/* Do Nothing. */
 		}
-		else
+#endif
+	}
+
+	/* The fan is driven for the spin up time without tach edges */
+	if(0 == g_app_duty[FAN_TACH_ZONE])
+	{
+		g_app_fanOffTick = Scheduler_getTicks() ;
+		g_app_fanStalled = FALSE ;
+	}
+	else if((Scheduler_getTicks() - g_app_fanOffTick) >= (APP_FAN_SPIN_UP_MS / SCHEDULER_TICK_MS))
+	{
+		g_app_fanStalled = Fan_IsStalled() ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+/* Refresh the fan state and the temperature on the LCD, the zones are shown in turn */
+void App_displayTask(void)
+{
+	uint8 zone = g_app_displayedZone ;
+	uint8 fan_state = (0 == g_app_duty[zone]) ? APP_FAN_OFF : APP_FAN_ON ;
+
+#if (APP_NUM_OF_ZONES > 1)
+	LCD_moveCursor(0, 0);
+	LCD_displayCharacter('Z');
+	LCD_integerToString(zone + 1);
+
+	/* The fan state row belongs to the previous zone */
+	g_app_displayedFanState = 0xFF ;
+	g_app_displayedZone = (zone + 1 < APP_NUM_OF_ZONES) ? (zone + 1) : 0 ;
+#endif
+
+	if((FAN_TACH_ZONE == zone) && (TRUE == g_app_fanStalled))
+	{
+		fan_state = APP_FAN_STALLED ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	if(fan_state != g_app_displayedFanState)
+	{
+		g_app_displayedFanState = fan_state ;
+		switch(fan_state)
 		{
-			/* Stop the motor */
+		case APP_FAN_OFF :
 			LCD_displayStringRowColumn(0, 4, "FAN is OFF");
-			Display_Temperature(temp);
-			DcMotor_Rotate(MOTOR_OFF, 0);
+			break;
+		case APP_FAN_ON :
+			LCD_displayStringRowColumn(0, 4, "FAN is ON ");
+			break;
+		default :
+			LCD_displayStringRowColumn(0, 4, "FAN STALL ");
+			break;
 		}
 	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	Display_Temperature(g_app_temperature[zone] / 10);
 
-	return 0 ;
+	/* Send only the changed characters to the LCD */
+	LCD_flush();
+}
+
+/* Send one telemetry frame for each zone, the frames are dropped if the UART is behind */
+void App_telemetryTask(void)
+{
+	Telemetry_SampleType sample ;
+	uint8 zone ;
+
+	sample.timestamp_ms = Scheduler_getTicks() * SCHEDULER_TICK_MS ;
+
+	for(zone = 0 ; zone < APP_NUM_OF_ZONES ; zone++)
+	{
+		sample.zone = zone ;
+		sample.adc_value = LM35_GetAdcValue(zone) ;
+		sample.temperature_dC = g_app_temperature[zone] ;
+		sample.duty = g_app_duty[zone] ;
+		sample.rpm = (FAN_TACH_ZONE == zone) ? Fan_GetRPM() : TELEMETRY_NO_RPM ;
+
+		Telemetry_send(&sample) ;
+	}
+}
+
+/* Correct the LM35 scale factors with the last bandgap measurement of the ADC reference */
+void App_calibrationTask(void)
+{
+	LM35_Calibrate() ;
 }
 
 void Display_Temperature(uint8 temp)
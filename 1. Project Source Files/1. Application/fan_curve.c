@@ -0,0 +1,189 @@
+/*
+ ============================================================================
+ Name        : fan_curve.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Fan Curve Engine
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/pgmspace.h>
+#include "fan_curve.h"
+#include "common_macros.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define FAN_CURVE_NO_BAND				0xFF
+
+/* Band of a constant temperature without hysteresis: the number of bands starting at or below it minus one */
+#define FAN_CURVE_BAND_STARTED(temp, lower_temp, speed, hysteresis)		+ ((temp) >= (lower_temp))
+#define FAN_CURVE_BAND_OF(temp)			((uint8)(-1 FAN_CURVE_BANDS(FAN_CURVE_BAND_STARTED, temp)))
+
+#define FAN_CURVE_ROW10(temp) \
+	FAN_CURVE_BAND_OF((temp) + 0), FAN_CURVE_BAND_OF((temp) + 1), FAN_CURVE_BAND_OF((temp) + 2), \
+	FAN_CURVE_BAND_OF((temp) + 3), FAN_CURVE_BAND_OF((temp) + 4), FAN_CURVE_BAND_OF((temp) + 5), \
+	FAN_CURVE_BAND_OF((temp) + 6), FAN_CURVE_BAND_OF((temp) + 7), FAN_CURVE_BAND_OF((temp) + 8), \
+	FAN_CURVE_BAND_OF((temp) + 9),
+
+#define FAN_CURVE_SPEED(arg, lower_temp, speed, hysteresis)				(speed),
+#define FAN_CURVE_HYSTERESIS(arg, lower_temp, speed, hysteresis)		(hysteresis),
+
+#if (FAN_CURVE_MAX_TEMP != 150)
+#error "The lookup table rows below should cover 0 to FAN_CURVE_MAX_TEMP"
+#endif
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+
+/* Band of each temperature, generated by the compiler from FAN_CURVE_BANDS and kept in the flash */
+static const uint8 g_fan_curve_table[FAN_CURVE_MAX_TEMP + 1] PROGMEM =
+{
+	FAN_CURVE_ROW10(0)
+	FAN_CURVE_ROW10(10)
+	FAN_CURVE_ROW10(20)
+	FAN_CURVE_ROW10(30)
+	FAN_CURVE_ROW10(40)
+	FAN_CURVE_ROW10(50)
+	FAN_CURVE_ROW10(60)
+	FAN_CURVE_ROW10(70)
+	FAN_CURVE_ROW10(80)
+	FAN_CURVE_ROW10(90)
+	FAN_CURVE_ROW10(100)
+	FAN_CURVE_ROW10(110)
+	FAN_CURVE_ROW10(120)
+	FAN_CURVE_ROW10(130)
+	FAN_CURVE_ROW10(140)
+	FAN_CURVE_BAND_OF(150)
+};
+
+static const uint8 g_fan_curve_speed[FAN_CURVE_NUM_OF_BANDS] = { FAN_CURVE_BANDS(FAN_CURVE_SPEED, 0) } ;
+static const uint8 g_fan_curve_hysteresis[FAN_CURVE_NUM_OF_BANDS] = { FAN_CURVE_BANDS(FAN_CURVE_HYSTERESIS, 0) } ;
+
+/* Current band of each zone */
+static uint8 g_fan_curve_band[FAN_CURVE_NUM_OF_ZONES] ;
+
+/****************************************************************************
+ * 						Private Functions Prototypes					    *
+ ****************************************************************************/
+static uint8 FanCurve_lookup(uint16 temperature);
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for forget the current band of all the zones, the next update gives a transition.
+ */
+void FanCurve_init(void)
+{
+	uint8 zone ;
+
+	for(zone = 0 ; zone < FAN_CURVE_NUM_OF_ZONES ; zone++)
+	{
+		g_fan_curve_band[zone] = FAN_CURVE_NO_BAND ;
+	}
+}
+
+/* Inputs:
+ * 	1. zone       : the fan zone index, it should be less than FAN_CURVE_NUM_OF_ZONES.
+ * 	2. temperature: the zone sensor reading in C.
+ *
+ * Return Value: TRUE when the band is changed, FALSE otherwise.
+ *
+ * Description:
+ * 	Function responsible for find the band of the temperature from the lookup table in constant time.
+ * 	A lower band is taken only when the temperature is below the current band by its hysteresis.
+ */
+boolean FanCurve_update(uint8 zone, uint8 temperature)
+{
+	uint8 band = FanCurve_lookup(temperature) ;
+	uint8 current ;
+	boolean changed = FALSE ;
+
+	if(zone < FAN_CURVE_NUM_OF_ZONES)
+	{
+		current = g_fan_curve_band[zone] ;
+
+		if((FAN_CURVE_NO_BAND == current) || (band > current))
+		{
+			/* First reading or rising, the band starts at its lower temperature */
+			changed = TRUE ;
+		}
+		else if(band < current)
+		{
+			/* Falling, the reading shifted up by the hysteresis should also be out of the current band */
+			band = FanCurve_lookup((uint16)temperature + g_fan_curve_hysteresis[current]) ;
+			changed = (band < current) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+
+		if(changed)
+		{
+			g_fan_curve_band[zone] = band ;
+		}
+	}
+
+	return changed ;
+}
+
+/* Inputs:
+ * 	1. zone: the fan zone index.
+ *
+ * Return Value: The current band index, 0 is the coolest band.
+ *
+ * Description:
+ * 	Function responsible for return the band selected by the last update.
+ */
+uint8 FanCurve_getBand(uint8 zone)
+{
+	uint8 band = 0 ;
+
+	if((zone < FAN_CURVE_NUM_OF_ZONES) && (g_fan_curve_band[zone] != FAN_CURVE_NO_BAND))
+	{
+		band = g_fan_curve_band[zone] ;
+	}
+
+	return band ;
+}
+
+/* Inputs:
+ * 	1. zone: the fan zone index.
+ *
+ * Return Value: The fan speed of the current band in percent.
+ *
+ * Description:
+ * 	Function responsible for return the speed of the band selected by the last update.
+ */
+uint8 FanCurve_getSpeed(uint8 zone)
+{
+	return g_fan_curve_speed[FanCurve_getBand(zone)] ;
+}
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+static uint8 FanCurve_lookup(uint16 temperature)
+{
+	if(temperature > FAN_CURVE_MAX_TEMP)
+	{
+		temperature = FAN_CURVE_MAX_TEMP ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return pgm_read_byte(&g_fan_curve_table[temperature]) ;
+}
@@ -0,0 +1,91 @@
+/*
+ ============================================================================
+ Name        : fan_curve.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Fan Curve Engine
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef FAN_CURVE_H_
+#define FAN_CURVE_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+#include "dc_motor.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* FAN_CURVE_BAND(arg, lower_temp, speed, hysteresis):
+ * 	1. arg       : used by the table generator, it is passed as it is.
+ * 	2. lower_temp: the band starts at this temperature in C when the temperature rises.
+ * 	3. speed     : fan speed in percent.
+ * 	4. hysteresis: the band is left downward only below (lower_temp - hysteresis).
+ * The bands are ordered by the temperature and the first one starts at 0 C. */
+#define FAN_CURVE_BANDS(FAN_CURVE_BAND, arg) \
+	FAN_CURVE_BAND(arg, 0,   0,   0) \
+	FAN_CURVE_BAND(arg, 30,  25,  2) \
+	FAN_CURVE_BAND(arg, 60,  50,  2) \
+	FAN_CURVE_BAND(arg, 90,  75,  2) \
+	FAN_CURVE_BAND(arg, 120, 100, 2)
+
+/* The lookup table covers the sensor range, the higher readings use the last entry */
+#define FAN_CURVE_MAX_TEMP				150
+
+/* Every fan zone follows the same curve with its own band */
+#define FAN_CURVE_NUM_OF_ZONES			DC_MOTOR_NUM_OF_ZONES
+
+#define FAN_CURVE_COUNT_BAND(arg, lower_temp, speed, hysteresis)		+ 1
+#define FAN_CURVE_NUM_OF_BANDS			(0 FAN_CURVE_BANDS(FAN_CURVE_COUNT_BAND, 0))
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for forget the current band of all the zones, the next update gives a transition.
+ */
+void FanCurve_init(void);
+
+/* Inputs:
+ * 	1. zone       : the fan zone index, it should be less than FAN_CURVE_NUM_OF_ZONES.
+ * 	2. temperature: the zone sensor reading in C.
+ *
+ * Return Value: TRUE when the band is changed, FALSE otherwise.
+ *
+ * Description:
+ * 	Function responsible for find the band of the temperature from the lookup table in constant time.
+ * 	A lower band is taken only when the temperature is below the current band by its hysteresis.
+ */
+boolean FanCurve_update(uint8 zone, uint8 temperature);
+
+/* Inputs:
+ * 	1. zone: the fan zone index.
+ *
+ * Return Value: The current band index, 0 is the coolest band.
+ *
+ * Description:
+ * 	Function responsible for return the band selected by the last update.
+ */
+uint8 FanCurve_getBand(uint8 zone);
+
+/* Inputs:
+ * 	1. zone: the fan zone index.
+ *
+ * Return Value: The fan speed of the current band in percent.
+ *
+ * Description:
+ * 	Function responsible for return the speed of the band selected by the last update.
+ */
+uint8 FanCurve_getSpeed(uint8 zone);
+
+
+#endif /* FAN_CURVE_H_ */
@@ -0,0 +1,217 @@
+/*
+ ============================================================================
+ Name        : scheduler.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Cooperative Tasks Scheduler
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/interrupt.h>
+#include "scheduler.h"
+#include "timer1.h"
+#include "power.h"
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static Scheduler_TaskType *g_scheduler_tasks = NULL_PTR ;
+static uint8 g_scheduler_count = 0 ;
+static volatile uint32 g_scheduler_ticks = 0 ;
+
+/****************************************************************************
+ * 						Private Functions Prototypes					    *
+ ****************************************************************************/
+static void Scheduler_tick(void);
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. tasks: pointer to the static tasks table, the first task has the highest priority.
+ * 	2. count: number of the tasks in the table.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for prepare the tasks table and start the system tick.
+ */
+void Scheduler_init(Scheduler_TaskType *tasks, uint8 count)
+{
+	uint8 index ;
+
+	g_scheduler_tasks = tasks ;
+	g_scheduler_count = count ;
+	g_scheduler_ticks = 0 ;
+
+	for(index = 0 ; index < count ; index++)
+	{
+		tasks[index].countdown = tasks[index].offset ;
+		tasks[index].pending = 0 ;
+		tasks[index].running = 0 ;
+		tasks[index].overruns = 0 ;
+	}
+
+	/* Timer1 keeps running freely, compare A gives the tick */
+	Timer1_init();
+	Timer1_startCompareA(TIMER1_US_TO_TICKS(SCHEDULER_TICK_MS * 1000UL), Scheduler_tick);
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for run the released tasks by their priority, it never returns.
+ * 	The CPU sleeps in Idle mode when no task is released, the next tick wakes it up.
+ */
+void Scheduler_run(void)
+{
+	uint8 index ;
+	boolean released ;
+	Scheduler_TaskType *task ;
+
+	while(1)
+	{
+		released = FALSE ;
+
+		for(index = 0 ; index < g_scheduler_count ; index++)
+		{
+			task = &g_scheduler_tasks[index] ;
+			if(task->pending != 0)
+			{
+				/* pending is written by the tick interrupt, running tells it the task did not finish yet */
+				cli();
+				task->pending = 0 ;
+				task->running = 1 ;
+				sei();
+
+				task->task();
+				task->running = 0 ;
+				released = TRUE ;
+
+				/* Start again from the highest priority task */
+				break;
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+		}
+
+		if(FALSE == released)
+		{
+			/* Check again with the interrupts disabled, Power_sleep enables them
+			 * only at the sleep instruction so a released task can not be missed */
+			cli();
+			for(index = 0 ; index < g_scheduler_count ; index++)
+			{
+				released |= (g_scheduler_tasks[index].pending != 0) ;
+			}
+			if(FALSE == released)
+			{
+				Power_sleep(POWER_IDLE);
+			}
+			else
+			{
+				sei();
+			}
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: Number of ticks from Scheduler_init.
+ *
+ * Description:
+ * 	Function responsible for return the system time in ticks.
+ */
+uint32 Scheduler_getTicks(void)
+{
+	uint32 ticks ;
+	uint8 sreg = SREG ;
+
+	cli();
+	ticks = g_scheduler_ticks ;
+	SREG = sreg ;
+
+	return ticks ;
+}
+
+/* Inputs: index: task index in the tasks table.
+ *
+ * Return Value: The overruns counter of the task.
+ *
+ * Description:
+ * 	Function responsible for return how many times the task was released while it was still pending or running.
+ */
+uint16 Scheduler_getOverruns(uint8 index)
+{
+	uint16 overruns = 0 ;
+	uint8 sreg = SREG ;
+
+	if(index < g_scheduler_count)
+	{
+		cli();
+		overruns = g_scheduler_tasks[index].overruns ;
+		SREG = sreg ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return overruns ;
+}
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Called from Timer1 compare A interrupt each tick, it releases the tasks which reached their period.
+ * 	A task still running at its release is an overrun, it is released again so it runs once more after it returns.
+ */
+static void Scheduler_tick(void)
+{
+	uint8 index ;
+	Scheduler_TaskType *task ;
+
+	g_scheduler_ticks++ ;
+
+	for(index = 0 ; index < g_scheduler_count ; index++)
+	{
+		task = &g_scheduler_tasks[index] ;
+		if(0 == task->countdown)
+		{
+			task->countdown = task->period ;
+			if(task->pending != 0)
+			{
+				task->overruns++ ;
+			}
+			else
+			{
+				task->overruns += (task->running != 0) ? 1 : 0 ;
+				task->pending = 1 ;
+			}
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+		task->countdown-- ;
+	}
+}
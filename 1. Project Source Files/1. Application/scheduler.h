@@ -0,0 +1,89 @@
+/*
+ ============================================================================
+ Name        : scheduler.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Cooperative Tasks Scheduler
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* System tick period, it is generated by Timer1 compare A */
+#define SCHEDULER_TICK_MS				1
+
+/* Initializer of a tasks table entry, the run time data starts cleared */
+#define SCHEDULER_TASK(period, offset, task)	{(period), (offset), (task), 0, 0, 0, 0}
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef struct
+{
+	/* Configuration */
+	uint16 period ;				/* in ticks */
+	uint16 offset ;				/* ticks before the first release, it spreads the tasks over the ticks */
+	void (*task)(void);
+
+	/* Run time data, it is cleared by Scheduler_init */
+	volatile uint16 countdown ;
+	volatile uint8 pending ;
+	volatile uint8 running ;	/* set by Scheduler_run around the task call */
+	volatile uint16 overruns ;	/* releases found still pending or running, the task did not finish in its period */
+}Scheduler_TaskType;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. tasks: pointer to the static tasks table, the first task has the highest priority.
+ * 	2. count: number of the tasks in the table.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for prepare the tasks table and start the system tick.
+ */
+void Scheduler_init(Scheduler_TaskType *tasks, uint8 count);
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for run the released tasks by their priority, it never returns.
+ * 	The CPU sleeps in Idle mode when no task is released, the next tick wakes it up.
+ */
+void Scheduler_run(void);
+
+/* Inputs: void.
+ *
+ * Return Value: Number of ticks from Scheduler_init.
+ *
+ * Description:
+ * 	Function responsible for return the system time in ticks.
+ */
+uint32 Scheduler_getTicks(void);
+
+/* Inputs: index: task index in the tasks table.
+ *
+ * Return Value: The overruns counter of the task.
+ *
+ * Description:
+ * 	Function responsible for return how many times the task was released while it was still pending or running.
+ */
+uint16 Scheduler_getOverruns(uint8 index);
+
+
+#endif /* SCHEDULER_H_ */
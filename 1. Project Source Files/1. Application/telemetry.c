@@ -0,0 +1,115 @@
+/*
+ ============================================================================
+ Name        : telemetry.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Binary Telemetry Stream
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "telemetry.h"
+#include "uart.h"
+#include "crc16.h"
+
+#if (TELEMETRY_FRAME_SIZE > UART_TX_BUFFER_SIZE)
+#error "The UART transmit buffer should hold a whole telemetry frame"
+#endif
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static uint16 g_telemetry_droppedFrames = 0 ;
+
+/****************************************************************************
+ * 						Private Functions Prototypes					    *
+ ****************************************************************************/
+static void Telemetry_putWord(uint8 *frame_ptr, uint16 value);
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for initialize the UART with the telemetry baud rate.
+ */
+void Telemetry_init(void)
+{
+	UART_ConfigType UART_ConfigStruct ;
+	UART_ConfigStruct.baud_rate = TELEMETRY_BAUD_RATE ;
+
+	UART_init(&UART_ConfigStruct) ;
+
+	g_telemetry_droppedFrames = 0 ;
+}
+
+/* Inputs:
+ * 	1. Pointer to the sample to be sent.
+ *
+ * Return Value: TRUE if the frame was queued, FALSE if it was dropped.
+ *
+ * Description:
+ * 	Function responsible for pack the sample in a frame and queue it for the UART interrupt.
+ * 	It never waits, if the transmit buffer has no space for the whole frame it is dropped and counted.
+ */
+boolean Telemetry_send(const Telemetry_SampleType *sample_ptr)
+{
+	uint8 frame[TELEMETRY_FRAME_SIZE] ;
+	boolean status = FALSE ;
+
+	if(sample_ptr != NULL_PTR)
+	{
+		frame[0] = TELEMETRY_SYNC_BYTE1 ;
+		frame[1] = TELEMETRY_SYNC_BYTE2 ;
+		frame[TELEMETRY_ZONE_OFFSET] = sample_ptr->zone ;
+		Telemetry_putWord(&frame[TELEMETRY_TIMESTAMP_OFFSET], (uint16)sample_ptr->timestamp_ms) ;
+		Telemetry_putWord(&frame[TELEMETRY_TIMESTAMP_OFFSET + 2], (uint16)(sample_ptr->timestamp_ms >> 16)) ;
+		Telemetry_putWord(&frame[TELEMETRY_ADC_OFFSET], sample_ptr->adc_value) ;
+		Telemetry_putWord(&frame[TELEMETRY_TEMPERATURE_OFFSET], sample_ptr->temperature_dC) ;
+		frame[TELEMETRY_DUTY_OFFSET] = sample_ptr->duty ;
+		Telemetry_putWord(&frame[TELEMETRY_RPM_OFFSET], sample_ptr->rpm) ;
+		Telemetry_putWord(&frame[TELEMETRY_CRC_OFFSET],
+				CRC16_compute(&frame[TELEMETRY_ZONE_OFFSET], TELEMETRY_CRC_OFFSET - TELEMETRY_ZONE_OFFSET)) ;
+
+		status = UART_send(frame, TELEMETRY_FRAME_SIZE) ;
+		if(FALSE == status)
+		{
+			g_telemetry_droppedFrames++ ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+
+	return status ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: Number of the frames dropped since the initialization.
+ *
+ * Description:
+ * 	Function responsible for return the dropped frames counter, the stream rate is too high if it increases.
+ */
+uint16 Telemetry_getDroppedFrames(void)
+{
+	return g_telemetry_droppedFrames ;
+}
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Store the 16-bit value in little endian order */
+static void Telemetry_putWord(uint8 *frame_ptr, uint16 value)
+{
+	frame_ptr[0] = (uint8)value ;
+	frame_ptr[1] = (uint8)(value >> 8) ;
+}
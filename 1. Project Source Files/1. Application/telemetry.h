@@ -0,0 +1,90 @@
+/*
+ ============================================================================
+ Name        : telemetry.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Binary Telemetry Stream
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define TELEMETRY_BAUD_RATE				9600
+
+/* Frame layout, the multi-byte fields are little endian:
+ * 	sync(2) zone(1) timestamp_ms(4) adc_value(2) temperature_dC(2) duty(1) rpm(2) crc(2)
+ * The CRC-16/CCITT-FALSE covers the bytes from the zone to the rpm.
+ * The offsets are shared with the host decoder. */
+#define TELEMETRY_SYNC_BYTE1			0xA5
+#define TELEMETRY_SYNC_BYTE2			0x5A
+
+#define TELEMETRY_ZONE_OFFSET			2
+#define TELEMETRY_TIMESTAMP_OFFSET		3
+#define TELEMETRY_ADC_OFFSET			7
+#define TELEMETRY_TEMPERATURE_OFFSET	9
+#define TELEMETRY_DUTY_OFFSET			11
+#define TELEMETRY_RPM_OFFSET			12
+#define TELEMETRY_CRC_OFFSET			14
+#define TELEMETRY_FRAME_SIZE			16
+
+/* The rpm value of a zone without tachometer */
+#define TELEMETRY_NO_RPM				0xFFFF
+
+/****************************************************************************
+ * 					          Types Declaration						        *
+ ****************************************************************************/
+typedef struct
+{
+	uint32 timestamp_ms ;
+	uint16 adc_value ;
+	uint16 temperature_dC ;
+	uint16 rpm ;
+	uint8 zone ;
+	uint8 duty ;
+
+}Telemetry_SampleType;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for initialize the UART with the telemetry baud rate.
+ */
+void Telemetry_init(void);
+
+/* Inputs:
+ * 	1. Pointer to the sample to be sent.
+ *
+ * Return Value: TRUE if the frame was queued, FALSE if it was dropped.
+ *
+ * Description:
+ * 	Function responsible for pack the sample in a frame and queue it for the UART interrupt.
+ * 	It never waits, if the transmit buffer has no space for the whole frame it is dropped and counted.
+ */
+boolean Telemetry_send(const Telemetry_SampleType *sample_ptr);
+
+/* Inputs: void.
+ *
+ * Return Value: Number of the frames dropped since the initialization.
+ *
+ * Description:
+ * 	Function responsible for return the dropped frames counter, the stream rate is too high if it increases.
+ */
+uint16 Telemetry_getDroppedFrames(void);
+
+
+#endif /* TELEMETRY_H_ */
@@ -12,6 +12,25 @@
  ****************************************************************************/
 #include "dc_motor.h"
 
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define DC_MOTOR_ZONE_DESCRIPTOR(in_port, in1_pin, in2_pin, pwm_channel) \
+	{(in_port), (1<<(in1_pin)) | (1<<(in2_pin)), (1<<(in2_pin)), (1<<(in1_pin)), (pwm_channel)},
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+
+/* Zones descriptors generated from DC_MOTOR_ZONES */
+static const DcMotor_ZoneType g_motor_zones[DC_MOTOR_NUM_OF_ZONES] =
+{
+	DC_MOTOR_ZONES(DC_MOTOR_ZONE_DESCRIPTOR)
+};
+
+/* Current direction on the motor pins of each zone, they are written only when it changes */
+static DcMotor_State g_motor_state[DC_MOTOR_NUM_OF_ZONES] ;
+
 /****************************************************************************
  * 							Functions Definitions						    *
  ****************************************************************************/
@@ -21,51 +40,120 @@
  * Return Value: void.
  *
  * Description:
- *	The Function responsible for setup the direction for the two motor pins through the GPIO driver.
- *	Stop at the DC-Motor at the beginning through the GPIO driver.
+ *	The Function responsible for setup the direction for the two motor pins of every zone through the GPIO driver.
+ *	Stop all the DC-Motors at the beginning through the GPIO driver.
+ *	Start the PWM channel of every zone once with ZERO duty cycle.
  */
 void DcMotor_Init(void)
 {
-	GPIO_setupPinDirection(L293D_IN1_PORT, L293D_IN1_PIN, PIN_OUTPUT);
-	GPIO_setupPinDirection(L293D_IN2_PORT, L293D_IN2_PIN, PIN_OUTPUT);
+	const PWM_Timer0_ConfigType PWM0_ConfigStruct = {PWM_NON_INVERTING, PWM_F_CPU_8, 0} ;
+	const PWM_Timer2_ConfigType PWM2_ConfigStruct = {PWM2_NON_INVERTING, PWM2_F_CPU_8, 0} ;
+	const DcMotor_ZoneType *zone_ptr ;
+	uint8 zone ;
+	uint8 pin ;
+
+	for(zone = 0 ; zone < DC_MOTOR_NUM_OF_ZONES ; zone++)
+	{
+		zone_ptr = &g_motor_zones[zone] ;
+
+		for(pin = 0 ; pin < NUM_OF_PINS_PER_PORT ; pin++)
+		{
+			if(BIT_IS_SET(zone_ptr->pins_mask, pin))
+			{
+				GPIO_setupPinDirection(zone_ptr->port, pin, PIN_OUTPUT);
+			}
+		}
 
-	PWM_Timer0_Start(0);
+		GPIO_writePortMasked(zone_ptr->port, zone_ptr->pins_mask, 0);
+		g_motor_state[zone] = MOTOR_OFF ;
+
+		switch(zone_ptr->pwm_channel)
+		{
+		case DC_MOTOR_PWM_OC0 :
+			PWM_Timer0_Init(&PWM0_ConfigStruct);
+			break;
+		case DC_MOTOR_PWM_OC2 :
+			PWM_Timer2_Init(&PWM2_ConfigStruct);
+			break;
+		}
+	}
 }
 
 /* Inputs:
- * 	1. state: The required DC Motor state, it should be CW or A-CW or stop.
- * 	2. speed: decimal value for the required motor speed, it should be from 0 → 100.
+ * 	1. zone : The motor zone index, it should be less than DC_MOTOR_NUM_OF_ZONES.
+ * 	2. state: The required DC Motor state, it should be CW or A-CW or stop.
+ * 	3. speed: decimal value for the required motor speed, it should be from 0 → 100.
  *
  * Return Value: void.
  *
  * Description:
  *	The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor
  *	based on the state input state value.
- *	Send the required duty cycle to the PWM driver based on the required speed value.
+ *	Convert the required speed percentage to a compare value with integer arithmetic.
  */
-void DcMotor_Rotate(DcMotor_State state,uint8 speed)
+void DcMotor_Rotate(uint8 zone,DcMotor_State state,uint8 speed)
 {
-	float duty_cycle ;
-	switch(state)
+	if(speed > DC_MOTOR_MAXIMUM_SPEED)
 	{
-	case MOTOR_OFF :
-		GPIO_writePin(L293D_IN1_PORT, L293D_IN1_PIN, LOGIC_LOW);
-		GPIO_writePin(L293D_IN2_PORT, L293D_IN2_PIN, LOGIC_LOW);
-		PWM_Timer0_Start(0);
-		break;
-	case MOTOR_CW :
-		duty_cycle = ((float)speed/100) ;
-		GPIO_writePin(L293D_IN1_PORT, L293D_IN1_PIN, LOGIC_LOW);
-		GPIO_writePin(L293D_IN2_PORT, L293D_IN2_PIN, LOGIC_HIGH);
-		PWM_Timer0_Start(duty_cycle);
-		break;
-	case MOTOR_ACW :
-		duty_cycle = ((float)speed/100) ;
-		GPIO_writePin(L293D_IN1_PORT, L293D_IN1_PIN, LOGIC_HIGH);
-		GPIO_writePin(L293D_IN2_PORT, L293D_IN2_PIN, LOGIC_LOW);
-		PWM_Timer0_Start(duty_cycle);
-		break;
+		speed = DC_MOTOR_MAXIMUM_SPEED ;
 	}
+
+	DcMotor_RotateRaw(zone, state, DC_MOTOR_SPEED_TO_DUTY(speed));
 }
 
+/* Inputs:
+ * 	1. zone : The motor zone index, it should be less than DC_MOTOR_NUM_OF_ZONES.
+ * 	2. state: The required DC Motor state, it should be CW or A-CW or stop.
+ * 	3. duty : The required compare value for the PWM driver, it should be from 0 → 255.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ *	The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor
+ *	with the full PWM resolution.
+ *	The motor pins are written together only if the state changes, so the
+ *	motor never passes through an invalid pins state.
+ *	If the zone index is not correct, The function will not handle the request.
+ */
+void DcMotor_RotateRaw(uint8 zone,DcMotor_State state,uint8 duty)
+{
+	const DcMotor_ZoneType *zone_ptr ;
 
+	if(zone < DC_MOTOR_NUM_OF_ZONES)
+	{
+		zone_ptr = &g_motor_zones[zone] ;
+
+		if(state != g_motor_state[zone])
+		{
+			switch(state)
+			{
+			case MOTOR_OFF :
+				GPIO_writePortMasked(zone_ptr->port, zone_ptr->pins_mask, 0);
+				break;
+			case MOTOR_CW :
+				GPIO_writePortMasked(zone_ptr->port, zone_ptr->pins_mask, zone_ptr->cw_value);
+				break;
+			case MOTOR_ACW :
+				GPIO_writePortMasked(zone_ptr->port, zone_ptr->pins_mask, zone_ptr->acw_value);
+				break;
+			}
+
+			g_motor_state[zone] = state ;
+		}
+
+		if(MOTOR_OFF == state)
+		{
+			duty = 0 ;
+		}
+
+		switch(zone_ptr->pwm_channel)
+		{
+		case DC_MOTOR_PWM_OC0 :
+			PWM_Timer0_SetDuty(duty);
+			break;
+		case DC_MOTOR_PWM_OC2 :
+			PWM_Timer2_SetDuty(duty);
+			break;
+		}
+	}
+}
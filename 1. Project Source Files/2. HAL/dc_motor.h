@@ -15,16 +15,33 @@
  ****************************************************************************/
 #include "gpio.h"
 #include "pwm_timer0.h"
+#include "pwm_timer2.h"
 
 /****************************************************************************
  * 								 Definitions								*
  ****************************************************************************/
-#define L293D_IN1_PORT		PORTB_ID
-#define L293D_IN1_PIN 		PIN0_ID
+#define DC_MOTOR_PWM_OC0			0
+#define DC_MOTOR_PWM_OC2			1
 
-#define L293D_IN2_PORT 		PORTB_ID
-#define L293D_IN2_PIN 		PIN1_ID
+/* DC_MOTOR_ZONE(in_port, in1_pin, in2_pin, pwm_channel): one L293D channel per fan zone.
+ * IN1 and IN2 pins are written together, so they are on the same port.
+ * Each zone needs its own PWM channel, Timer1 is used by the scheduler so OC0 and OC2 are available. */
+#define DC_MOTOR_ZONES(DC_MOTOR_ZONE) \
+	DC_MOTOR_ZONE(PORTB_ID, PIN0_ID, PIN1_ID, DC_MOTOR_PWM_OC0) \
+	DC_MOTOR_ZONE(PORTB_ID, PIN4_ID, PIN5_ID, DC_MOTOR_PWM_OC2)
 
+#define DC_MOTOR_COUNT_ZONE(in_port, in1_pin, in2_pin, pwm_channel)		+ 1
+#define DC_MOTOR_NUM_OF_ZONES		(0 DC_MOTOR_ZONES(DC_MOTOR_COUNT_ZONE))
+
+#if (DC_MOTOR_NUM_OF_ZONES > 2)
+#error "The ATmega32 has two free PWM channels, so two DC motor zones at most"
+#endif
+
+#define DC_MOTOR_MAXIMUM_SPEED		100
+
+/* Convert speed percentage 0 → 100 to compare value 0 → 255 without division,
+ * 653/256 is 2.55 so 100% gives 255 and the product fits in 16 bits */
+#define DC_MOTOR_SPEED_TO_DUTY(speed)	((uint8)(((uint16)(speed) * 653) >> 8))
 
 /****************************************************************************
  * 					          Types Declaration						        *
@@ -36,6 +53,17 @@ typedef enum
 	MOTOR_ACW
 }DcMotor_State;
 
+/* Zone descriptor, the pins values are computed at compile time so a state change is one masked write */
+typedef struct
+{
+	uint8 port;
+	uint8 pins_mask;
+	uint8 cw_value;
+	uint8 acw_value;
+	uint8 pwm_channel;
+
+}DcMotor_ZoneType;
+
 /****************************************************************************
  * 							Functions Prototypes						    *
  ****************************************************************************/
@@ -45,23 +73,40 @@ typedef enum
  * Return Value: void.
  *
  * Description:
- *	The Function responsible for setup the direction for the two motor pins through the GPIO driver.
- *	Stop at the DC-Motor at the beginning through the GPIO driver.
+ *	The Function responsible for setup the direction for the two motor pins of every zone through the GPIO driver.
+ *	Stop all the DC-Motors at the beginning through the GPIO driver.
+ *	Start the PWM channel of every zone once with ZERO duty cycle.
  */
 void DcMotor_Init(void);
 
 /* Inputs:
- * 	1. state: The required DC Motor state, it should be CW or A-CW or stop.
- * 	2. speed: decimal value for the required motor speed, it should be from 0 → 100.
+ * 	1. zone : The motor zone index, it should be less than DC_MOTOR_NUM_OF_ZONES.
+ * 	2. state: The required DC Motor state, it should be CW or A-CW or stop.
+ * 	3. speed: decimal value for the required motor speed, it should be from 0 → 100.
  *
  * Return Value: void.
  *
  * Description:
  *	The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor
  *	based on the state input state value.
- *	Send the required duty cycle to the PWM driver based on the required speed value.
+ *	Convert the required speed percentage to a compare value with integer arithmetic.
+ */
+void DcMotor_Rotate(uint8 zone,DcMotor_State state,uint8 speed);
+
+/* Inputs:
+ * 	1. zone : The motor zone index, it should be less than DC_MOTOR_NUM_OF_ZONES.
+ * 	2. state: The required DC Motor state, it should be CW or A-CW or stop.
+ * 	3. duty : The required compare value for the PWM driver, it should be from 0 → 255.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ *	The function responsible for rotate the DC Motor CW/ or A-CW or stop the motor
+ *	with the full PWM resolution.
+ *	The motor pins are written only if the state changes.
+ *	If the zone index is not correct, The function will not handle the request.
  */
-void DcMotor_Rotate(DcMotor_State state,uint8 speed);
+void DcMotor_RotateRaw(uint8 zone,DcMotor_State state,uint8 duty);
 
 
 #endif /* DC_MOTOR_H_ */
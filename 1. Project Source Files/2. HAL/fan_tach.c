@@ -0,0 +1,161 @@
+/*
+ ============================================================================
+ Name        : fan_tach.c
+ Author      : Ahmed Shawky
+ Description : Source File for Fan Tachometer Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/interrupt.h>
+#include "fan_tach.h"
+#include "ring_buffer.h"
+
+#if ((FAN_TACH_AVERAGE_PERIODS & (FAN_TACH_AVERAGE_PERIODS - 1)) != 0) || (FAN_TACH_AVERAGE_PERIODS > 64)
+#error "FAN_TACH_AVERAGE_PERIODS must be a power of two and not more than 64"
+#endif
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* N periods need N + 1 edges */
+#define FAN_TACH_EDGES_BUFFER_SIZE		(FAN_TACH_AVERAGE_PERIODS * 2)
+
+#define FAN_TACH_TICKS_PER_MINUTE		(60UL * (F_CPU / TIMER1_PRESCALER))
+#define FAN_TACH_STALL_TIMEOUT_TICKS	TIMER1_US_TO_TICKS((uint32)FAN_TACH_STALL_TIMEOUT_MS * 1000)
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+
+/* Time of the last edges, the ISR pushes them and the oldest are overwritten, they are never popped */
+static volatile uint32 g_fan_tach_edges[FAN_TACH_EDGES_BUFFER_SIZE] ;
+static RingBuffer_Type g_fan_tach_ring ;
+
+/* Number of stored edges, it stops at the buffer size */
+static volatile uint8 g_fan_tach_count = 0 ;
+
+/****************************************************************************
+ * 						  Private Functions Prototypes					    *
+ ****************************************************************************/
+static void Fan_tachEdge(uint32 timestamp);
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for setup the ICP1 pin as input with pull up and start capturing its falling edges.
+ * 	The input capture ISR only stores the edge time, the speed is computed when it is requested.
+ */
+void Fan_TachInit(void)
+{
+	GPIO_STATIC_SETUP_PIN_DIRECTION(FAN_TACH_ICP_PORT_ID, FAN_TACH_ICP_PIN_ID, PIN_INPUT);
+	GPIO_STATIC_WRITE_PIN(FAN_TACH_ICP_PORT_ID, FAN_TACH_ICP_PIN_ID, LOGIC_HIGH);
+
+	RingBuffer_init(&g_fan_tach_ring, g_fan_tach_edges, sizeof(uint32), FAN_TACH_EDGES_BUFFER_SIZE);
+	g_fan_tach_count = 0 ;
+
+	Timer1_init();
+	Timer1_startCapture(TIMER1_FALLING_EDGE, Fan_tachEdge);
+}
+
+/* Inputs: void.
+ *
+ * Return Value: The fan speed in revolutions per minute, ZERO if the fan is stopped.
+ *
+ * Description:
+ * 	Function responsible for compute the speed from the time of the last FAN_TACH_AVERAGE_PERIODS periods.
+ * 	It never waits for an edge, the stored edges are used.
+ */
+uint16 Fan_GetRPM(void)
+{
+	uint32 newest ;
+	uint32 oldest ;
+	uint8 periods ;
+	uint8 count ;
+	uint16 rpm = 0 ;
+	uint8 sreg = SREG ;
+
+	/* Take the edges of the same ISR run */
+	cli();
+	count = g_fan_tach_count ;
+	periods = (count > FAN_TACH_AVERAGE_PERIODS) ? FAN_TACH_AVERAGE_PERIODS : ((count != 0) ? (count - 1) : 0) ;
+	RingBuffer_peekNewest(&g_fan_tach_ring, 0, &newest);
+	RingBuffer_peekNewest(&g_fan_tach_ring, periods, &oldest);
+	SREG = sreg ;
+
+	if((periods > 0) && (FALSE == Fan_IsStalled()) && (newest != oldest))
+	{
+		/* RPM = periods * ticks per minute / (pulses per revolution * ticks of the periods) */
+		rpm = (uint16)(((uint32)periods * FAN_TACH_TICKS_PER_MINUTE) / ((newest - oldest) * FAN_TACH_PULSES_PER_REV)) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return rpm ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE if there was no tach edge for FAN_TACH_STALL_TIMEOUT_MS, FALSE otherwise.
+ *
+ * Description:
+ * 	Function responsible for detect a stopped fan, it is a stall only if the fan is driven.
+ */
+boolean Fan_IsStalled(void)
+{
+	boolean stalled = TRUE ;
+	uint32 newest ;
+	uint8 sreg = SREG ;
+
+	cli();
+	RingBuffer_peekNewest(&g_fan_tach_ring, 0, &newest);
+	if((g_fan_tach_count != 0) && ((Timer1_getTimestamp() - newest) < FAN_TACH_STALL_TIMEOUT_TICKS))
+	{
+		stalled = FALSE ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	SREG = sreg ;
+
+	return stalled ;
+}
+
+/****************************************************************************
+ * 						   Private Functions Definitions				    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. timestamp: Timer1 time of the tach edge.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for store the edge time, it is called from the input capture ISR.
+ */
+static void Fan_tachEdge(uint32 timestamp)
+{
+	RingBuffer_pushOverwrite(&g_fan_tach_ring, &timestamp);
+
+	if(g_fan_tach_count < FAN_TACH_EDGES_BUFFER_SIZE)
+	{
+		g_fan_tach_count++ ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
@@ -0,0 +1,73 @@
+/*
+ ============================================================================
+ Name        : fan_tach.h
+ Author      : Ahmed Shawky
+ Description : Header File for Fan Tachometer Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef FAN_TACH_H_
+#define FAN_TACH_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+#include "gpio.h"
+#include "timer1.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The tach output is an open collector on the ICP1 pin, there is only one ICP pin
+ * so the tachometer measures the fan of one zone */
+#define FAN_TACH_ICP_PORT_ID			PORTD_ID
+#define FAN_TACH_ICP_PIN_ID				PIN6_ID
+#define FAN_TACH_ZONE					0
+
+/* Most PC fans give two pulses per revolution */
+#define FAN_TACH_PULSES_PER_REV			2
+
+/* The speed is the average of the last tach periods, it must be a power of two (max 64) */
+#define FAN_TACH_AVERAGE_PERIODS		4
+
+/* No tach edge for this time means the fan is stopped */
+#define FAN_TACH_STALL_TIMEOUT_MS		500
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for setup the ICP1 pin as input with pull up and start capturing its falling edges.
+ * 	The input capture ISR only stores the edge time, the speed is computed when it is requested.
+ */
+void Fan_TachInit(void);
+
+/* Inputs: void.
+ *
+ * Return Value: The fan speed in revolutions per minute, ZERO if the fan is stopped.
+ *
+ * Description:
+ * 	Function responsible for compute the speed from the time of the last FAN_TACH_AVERAGE_PERIODS periods.
+ * 	It never waits for an edge, the stored edges are used.
+ */
+uint16 Fan_GetRPM(void);
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE if there was no tach edge for FAN_TACH_STALL_TIMEOUT_MS, FALSE otherwise.
+ *
+ * Description:
+ * 	Function responsible for detect a stopped fan, it is a stall only if the fan is driven.
+ */
+boolean Fan_IsStalled(void);
+
+
+#endif /* FAN_TACH_H_ */
@@ -12,6 +12,83 @@
  ****************************************************************************/
 #include "lcd.h"
 
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+/* The bus timing is in nanoseconds and the execution time is covered by polling the busy flag */
+#define LCD_BUS_DELAY()					 _delay_us(1)
+#else
+/* Each bus phase waits long enough to cover the execution time of the previous byte */
+#define LCD_BUS_DELAY()					 _delay_ms(1)
+#endif
+
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+#if ((LCD_ASYNC_QUEUE_SIZE & (LCD_ASYNC_QUEUE_SIZE - 1)) != 0) || (LCD_ASYNC_QUEUE_SIZE > 128)
+#error "LCD_ASYNC_QUEUE_SIZE must be a power of two and not more than 128"
+#endif
+
+/* Queue entries hold the byte in the low 8 bits and the RS value in bit 8 */
+#define LCD_QUEUE_RS_BIT				 8
+
+/* Number of ticks to wait after the clear and return home commands */
+#define LCD_LONG_COMMAND_TICKS			 ((LCD_LONG_COMMAND_US + LCD_ASYNC_TICK_US - 1) / LCD_ASYNC_TICK_US)
+
+/****************************************************************************
+ * 					          Types Declaration						        *
+ ****************************************************************************/
+typedef enum
+{
+	LCD_ASYNC_IDLE,					/* Wait for the last command execution then start the next byte */
+	LCD_ASYNC_LATCH_HIGH_NIBBLE,	/* E=0 to latch the higher 4 bits in 4-bits mode */
+	LCD_ASYNC_SETUP_LOW_NIBBLE,		/* Out the lower 4 bits with E=1 in 4-bits mode */
+	LCD_ASYNC_LATCH_LAST			/* E=0 to latch the byte or the lower 4 bits */
+}LCD_AsyncState;
+#endif
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+
+/* Screen shadow holds the required content and panel copy holds the content on the screen */
+static uint8 g_lcd_shadow[LCD_ROWS][LCD_COLS] ;
+static uint8 g_lcd_panel[LCD_ROWS][LCD_COLS] ;
+
+/* Shadow cursor position used by the display functions */
+static uint8 g_lcd_cursorRow = 0 ;
+static uint8 g_lcd_cursorCol = 0 ;
+
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+/* Bytes queue, LCD_enqueue is the only writer of the head and the tick is the only writer of the tail */
+static volatile uint16 g_lcd_queue[LCD_ASYNC_QUEUE_SIZE] ;
+static volatile uint8 g_lcd_queueHead = 0 ;
+static volatile uint8 g_lcd_queueTail = 0 ;
+
+/* Transfer state machine, it runs in the Timer1 compare B interrupt */
+static volatile LCD_AsyncState g_lcd_asyncState = LCD_ASYNC_IDLE ;
+static volatile uint16 g_lcd_asyncEntry = 0 ;
+#if(LCD_BUSY_FLAG_DISABLED == LCD_BUSY_FLAG_MODE)
+static volatile uint8 g_lcd_asyncWaitTicks = 0 ;
+#endif
+static volatile boolean g_lcd_asyncBusy = FALSE ;
+#endif
+
+/****************************************************************************
+ * 						  Private Functions Prototypes					    *
+ ****************************************************************************/
+static void LCD_sendData(uint8 data);
+static void LCD_setPanelCursor(uint8 row, uint8 col);
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+static uint8 LCD_readBusyFlag(void);
+#if(LCD_BLOCKING_BACKEND == LCD_BACKEND)
+static void LCD_waitBusyFlag(void);
+#endif
+#endif
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+static boolean LCD_enqueue(uint16 entry);
+static uint8 LCD_queueSpace(void);
+static void LCD_waitQueueSpace(void);
+static void LCD_writeDataBus(uint8 value);
+static void LCD_asyncTick(void);
+#endif
+
 /****************************************************************************
  * 							Functions Definitions						    *
  ****************************************************************************/
@@ -27,21 +104,35 @@
  */
 void LCD_init(void)
 {
+	uint8 row ;
+	uint8 col ;
+
 	/* Configure the direction for RS and E pins as output pins */
-	GPIO_setupPinDirection(LCD_RS_PORT_ID, LCD_RS_PIN_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_E_PORT_ID, LCD_E_PIN_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_RS_PORT_ID, LCD_RS_PIN_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_E_PORT_ID, LCD_E_PIN_ID, PIN_OUTPUT);
+
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+	/* Configure the direction for R/W pin as output pin and start in write mode R/W=0 */
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_RW_PORT_ID, LCD_RW_PIN_ID, PIN_OUTPUT);
+	GPIO_STATIC_WRITE_PIN(LCD_RW_PORT_ID, LCD_RW_PIN_ID, LOGIC_LOW);
+#endif
+
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+	/* Timer1 drives the transfer ticks */
+	Timer1_init();
+#endif
 
 	/* LCD Power ON delay always > 15ms */
 	_delay_ms(20);
 
 	/* Configure the data port as output port */
 #if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
-	GPIO_setupPortDirection(LCD_DATA_PORT_ID, PORT_OUTPUT);
+	GPIO_STATIC_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID, PORT_OUTPUT);
 #elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, PIN_OUTPUT);
 
 	/* Send for 4 bit initialization of LCD  */
 	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE_INIT1);
@@ -57,6 +148,15 @@ void LCD_init(void)
 	/* Send clear LCD command at the beginning. */
 	LCD_sendCommand(LCD_CLEAR_COMMAND);
 
+	/* The screen is blank, so the shadow and the screen copy are blank too */
+	for(row = 0 ; row < LCD_ROWS ; row++)
+	{
+		for(col = 0 ; col < LCD_COLS ; col++)
+		{
+			g_lcd_shadow[row][col] = ' ' ;
+			g_lcd_panel[row][col] = ' ' ;
+		}
+	}
 }
 
 /* Inputs:
@@ -65,63 +165,70 @@ void LCD_init(void)
  * Return Value: void.
  *
  * Description:
- * 	Send the required command to the screen
+ * 	Send the required command to the screen.
+ * 	In asynchronous backend the command is queued, it waits only if the queue is full.
+ * 	If the interrupts are disabled while the queue is full, the bus phases are done by polling.
  */
 void LCD_sendCommand(uint8 command)
 {
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+	/* Wait for a free place in the queue */
+	LCD_waitQueueSpace();
+	LCD_enqueue(command);
+#else
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+	/* Wait until the previous byte is executed */
+	LCD_waitBusyFlag();
+#endif
+
 	/* Instruction Mode RS=0 */
-	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_LOW);
 	/* delay for processing Tas = 50ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Enable LCD E=1 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
 	/* delay for processing Tpw - Tdws = 190ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 #if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
 	/* out the required command to the data bus D0 --> D7 */
-	GPIO_writePort(LCD_DATA_PORT_ID, command);
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID, command);
 	/* delay for processing Tdsw = 100ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Disable LCD E=0 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
 	/* delay for processing Th = 13ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 #elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
 	/* out the higher 4 bits of required command to the data bus */
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, GET_BIT(command,4));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, GET_BIT(command,5));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, GET_BIT(command,6));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, GET_BIT(command,7));
+	GPIO_writePinsShifted(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, 4, command >> 4);
 
 	/* delay for processing Tdsw = 100ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Disable LCD E=0 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
 	/* delay for processing Th = 13ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Enable LCD E=1 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
 	/* delay for processing Tpw - Tdws = 190ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* out the lower 4 bits of required command to the data bus */
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, GET_BIT(command,0));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, GET_BIT(command,1));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, GET_BIT(command,2));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, GET_BIT(command,3));
+	GPIO_writePinsShifted(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, 4, command & 0x0F);
 
 	/* delay for processing Tdsw = 100ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Disable LCD E=0 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
 	/* delay for processing Th = 13ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
+#endif
 #endif
 }
 
@@ -131,82 +238,254 @@ void LCD_sendCommand(uint8 command)
  * Return Value: void.
  *
  * Description:
- * 	Display the required character on the screen.
+ * 	Write the required character in the screen shadow at the current cursor position
+ * 	then move the cursor to the next column, it will be displayed by LCD_flush.
  */
 void LCD_displayCharacter(uint8 data)
 {
+	/* Characters outside the screen are dropped */
+	if((g_lcd_cursorRow < LCD_ROWS) && (g_lcd_cursorCol < LCD_COLS))
+	{
+		g_lcd_shadow[g_lcd_cursorRow][g_lcd_cursorCol] = data ;
+		g_lcd_cursorCol++ ;
+	}
+}
+
+/* Inputs:
+ * 	1. Pointer to the required string (array of characters) to be sent to the screen.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Write the required string in the screen shadow at the current cursor position.
+ */
+void LCD_displayString(const char *Str)
+{
+	uint8 index = 0 ;
+	while(Str[index] != '\0')
+	{
+		LCD_displayCharacter(Str[index]);
+		index++ ;
+	}
+}
+
+/* Inputs:
+ * 	1. The required row.
+ * 	2. The required column.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Move the shadow cursor to a specified row and column index on the screen.
+ */
+void LCD_moveCursor(uint8 row, uint8 col)
+{
+	g_lcd_cursorRow = row ;
+	g_lcd_cursorCol = col ;
+}
+
+/* Inputs:
+ * 	1. The required row.
+ * 	2. The required column.
+ * 	3. Pointer to the required string (array of characters) to be sent to the screen.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Write the required string in the screen shadow in a specified row and column index.
+ */
+void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str)
+{
+	/* go to to the required LCD position */
+	LCD_moveCursor(row,col);
+
+	/* display the string */
+	LCD_displayString(Str);
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Clear the screen shadow by filling it with spaces.
+ */
+void LCD_clearScreen(void)
+{
+	uint8 row ;
+	uint8 col ;
+
+	for(row = 0 ; row < LCD_ROWS ; row++)
+	{
+		for(col = 0 ; col < LCD_COLS ; col++)
+		{
+			g_lcd_shadow[row][col] = ' ' ;
+		}
+	}
+
+	g_lcd_cursorRow = 0 ;
+	g_lcd_cursorCol = 0 ;
+}
+
+/* Inputs:
+ * 	1. The required decimal value to convert it to character to display it on the screen.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Write the required decimal value in the screen shadow.
+ */
+void LCD_integerToString(int data)
+{
+	/* String to hold the ascii result */
+	char buff[16];
+
+	/* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
+	itoa(data,buff,10);
+
+	/* Display the string */
+	LCD_displayString(buff);
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Send to the screen only the shadow cells which differ from the screen content.
+ * 	Adjacent changed cells in the same row are sent after a single cursor move command.
+ */
+void LCD_flush(void)
+{
+	uint8 row ;
+	uint8 col ;
+	boolean cursor_in_place ;
+
+	for(row = 0 ; row < LCD_ROWS ; row++)
+	{
+		/* The screen cursor is not known to be at the first cell of this row */
+		cursor_in_place = FALSE ;
+
+		for(col = 0 ; col < LCD_COLS ; col++)
+		{
+			if(g_lcd_shadow[row][col] != g_lcd_panel[row][col])
+			{
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+				/* Never wait for the queue, the remaining cells are sent in the next flush */
+				if(LCD_queueSpace() < 2)
+				{
+					return;
+				}
+#endif
+
+				/* The screen cursor moves automatically after each character,
+				 * so it is moved only at the start of each group of changed cells */
+				if(FALSE == cursor_in_place)
+				{
+					LCD_setPanelCursor(row, col);
+					cursor_in_place = TRUE ;
+				}
+
+				LCD_sendData(g_lcd_shadow[row][col]);
+				g_lcd_panel[row][col] = g_lcd_shadow[row][col] ;
+			}
+			else
+			{
+				cursor_in_place = FALSE ;
+			}
+		}
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE if all the queued bytes are sent to the screen, otherwise FALSE.
+ *
+ * Description:
+ * 	Check the progress of the asynchronous backend, the blocking backend is always idle.
+ */
+boolean LCD_isIdle(void)
+{
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+	return (FALSE == g_lcd_asyncBusy) ;
+#else
+	return TRUE ;
+#endif
+}
+
+/****************************************************************************
+ * 						   Private Functions Definitions				    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. The required character to be sent to the screen.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Send the required character to the screen at the screen cursor position.
+ */
+static void LCD_sendData(uint8 data)
+{
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
+	/* Wait for a free place in the queue */
+	LCD_waitQueueSpace();
+	LCD_enqueue((1<<LCD_QUEUE_RS_BIT) | data);
+#else
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+	/* Wait until the previous byte is executed */
+	LCD_waitBusyFlag();
+#endif
+
 	/* Data Mode RS=1 */
-	GPIO_writePin(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_HIGH);
+	GPIO_STATIC_WRITE_PIN(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_HIGH);
 	/* delay for processing Tas = 50ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Enable LCD E=1 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
 	/* delay for processing Tpw - Tdws = 190ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 #if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
 	/* out the required data to the data bus D0 --> D7 */
-	GPIO_writePort(LCD_DATA_PORT_ID, data);
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID, data);
 	/* delay for processing Tdsw = 100ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Disable LCD E=0 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
 	/* delay for processing Th = 13ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 #elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
 	/* out the higher 4 bits of required data to the data bus */
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, GET_BIT(data,4));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, GET_BIT(data,5));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, GET_BIT(data,6));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, GET_BIT(data,7));
+	GPIO_writePinsShifted(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, 4, data >> 4);
 
 	/* delay for processing Tdsw = 100ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Disable LCD E=0 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
 	/* delay for processing Th = 13ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Enable LCD E=1 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
 	/* delay for processing Tpw - Tdws = 190ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* out the lower 4 bits of required data to the data bus */
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, GET_BIT(data,0));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, GET_BIT(data,1));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, GET_BIT(data,2));
-	GPIO_writePin(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, GET_BIT(data,3));
+	GPIO_writePinsShifted(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, 4, data & 0x0F);
 
 	/* delay for processing Tdsw = 100ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
 
 	/* Disable LCD E=0 */
-	GPIO_writePin(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
 	/* delay for processing Th = 13ns */
-	_delay_ms(1);
+	LCD_BUS_DELAY();
+#endif
 #endif
-}
-
-/* Inputs:
- * 	1. Pointer to the required string (array of characters) to be sent to the screen.
- *
- * Return Value: void.
- *
- * Description:
- * 	Display the required string on the screen.
- */
-void LCD_displayString(const char *Str)
-{
-	uint8 index = 0 ;
-	while(Str[index] != '\0')
-	{
-		LCD_displayCharacter(Str[index]);
-		index++ ;
-	}
 }
 
 /* Inputs:
@@ -216,9 +495,9 @@ void LCD_displayString(const char *Str)
  * Return Value: void.
  *
  * Description:
- * 	Move the cursor to a specified row and column index on the screen.
+ * 	Move the screen cursor to a specified row and column index.
  */
-void LCD_moveCursor(uint8 row, uint8 col)
+static void LCD_setPanelCursor(uint8 row, uint8 col)
 {
 	uint8 lcd_memory_address = 0 ;
 
@@ -243,23 +522,48 @@ void LCD_moveCursor(uint8 row, uint8 col)
 	LCD_sendCommand(lcd_memory_address | LCD_SET_CURSOR_LOCATION);
 }
 
+#if(LCD_ASYNC_BACKEND == LCD_BACKEND)
 /* Inputs:
- * 	1. The required row.
- * 	2. The required column.
- * 	3. Pointer to the required string (array of characters) to be sent to the screen.
+ * 	1. The queue entry, the byte with the RS value in bit 8.
  *
- * Return Value: void.
+ * Return Value: TRUE if the entry is queued, FALSE if the queue is full.
  *
  * Description:
- * 	Display the required string in a specified row and column index on the screen.
+ * 	Add a byte to the asynchronous backend queue and start the transfer ticks if they are stopped.
  */
-void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str)
+static boolean LCD_enqueue(uint16 entry)
 {
-	/* go to to the required LCD position */
-	LCD_moveCursor(row,col);
+	boolean status = FALSE ;
+	uint8 head = g_lcd_queueHead ;
 
-	/* display the string */
-	LCD_displayString(Str);
+	if((uint8)(head - g_lcd_queueTail) < LCD_ASYNC_QUEUE_SIZE)
+	{
+		g_lcd_queue[head & (LCD_ASYNC_QUEUE_SIZE - 1)] = entry ;
+		g_lcd_queueHead = head + 1 ;
+
+		/* The tick stops itself when the queue is empty, so restart it */
+		if(FALSE == g_lcd_asyncBusy)
+		{
+			g_lcd_asyncBusy = TRUE ;
+			Timer1_startCompareB(TIMER1_US_TO_TICKS(LCD_ASYNC_TICK_US), LCD_asyncTick);
+		}
+
+		status = TRUE ;
+	}
+
+	return status ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: Number of free places in the queue.
+ *
+ * Description:
+ * 	Return the number of bytes which can be queued without waiting.
+ */
+static uint8 LCD_queueSpace(void)
+{
+	return LCD_ASYNC_QUEUE_SIZE - (uint8)(g_lcd_queueHead - g_lcd_queueTail) ;
 }
 
 /* Inputs: void.
@@ -267,31 +571,210 @@ void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str)
  * Return Value: void.
  *
  * Description:
- * 	Send the clear screen command.
+ * 	Wait until the queue has a free place.
+ * 	The compare B interrupt can not run while the interrupts are disabled (before sei or inside an ISR),
+ * 	so in this case the bus phases are done here one tick apart, then the tick is restarted
+ * 	to drop its pending flag and give the next phase a full tick.
  */
-void LCD_clearScreen(void)
+static void LCD_waitQueueSpace(void)
 {
-	/* Send clear display command */
-	LCD_sendCommand(LCD_CLEAR_COMMAND);
+	while(0 == LCD_queueSpace())
+	{
+		if(SREG & (1<<SREG_I))
+		{
+			/* The compare B interrupt frees a place */
+		}
+		else
+		{
+			_delay_us(LCD_ASYNC_TICK_US);
+			LCD_asyncTick();
+			Timer1_startCompareB(TIMER1_US_TO_TICKS(LCD_ASYNC_TICK_US), LCD_asyncTick);
+		}
+	}
 }
 
 /* Inputs:
- * 	1. The required decimal value to convert it to character to display it on the screen.
+ * 	1. The value to be put on the data bus, the lower 4 bits only in 4-bits mode.
  *
  * Return Value: void.
  *
  * Description:
- * 	Display the required decimal value on the screen
+ * 	Out the required value on the LCD data bus pins.
  */
-void LCD_integerToString(int data)
+static void LCD_writeDataBus(uint8 value)
 {
-	/* String to hold the ascii result */
-	char buff[16];
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
+	GPIO_STATIC_WRITE_PORT(LCD_DATA_PORT_ID, value);
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+	GPIO_writePinsShifted(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, 4, value);
+#endif
+}
 
-	/* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
-	itoa(data,buff,10);
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Asynchronous backend state machine, called from the Timer1 compare B interrupt each tick.
+ * 	Each call does one bus phase, so the E pulse width and the data setup/hold times are
+ * 	one tick long, and the next byte starts one tick after the last latch which covers
+ * 	the 40us command execution time. The clear and return home commands wait more ticks.
+ */
+static void LCD_asyncTick(void)
+{
+	uint8 tail ;
+	uint8 data = (uint8)g_lcd_asyncEntry ;
 
-	/* Display the string */
-	LCD_displayString(buff);
+	switch(g_lcd_asyncState)
+	{
+	case LCD_ASYNC_IDLE :
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+		/* Check the busy flag once each tick instead of waiting the worst case time */
+		if(LCD_readBusyFlag())
+		{
+			/* Try again next tick */
+		}
+#else
+		if(g_lcd_asyncWaitTicks != 0)
+		{
+			g_lcd_asyncWaitTicks-- ;
+		}
+#endif
+		else if(g_lcd_queueHead == g_lcd_queueTail)
+		{
+			/* Nothing to send, stop the ticks until the next byte is queued */
+			Timer1_stopCompareB();
+			g_lcd_asyncBusy = FALSE ;
+		}
+		else
+		{
+			tail = g_lcd_queueTail ;
+			g_lcd_asyncEntry = g_lcd_queue[tail & (LCD_ASYNC_QUEUE_SIZE - 1)] ;
+			g_lcd_queueTail = tail + 1 ;
+			data = (uint8)g_lcd_asyncEntry ;
+
+			/* Instruction Mode RS=0 or Data Mode RS=1 */
+			GPIO_STATIC_WRITE_PIN(LCD_RS_PORT_ID, LCD_RS_PIN_ID, GET_BIT(g_lcd_asyncEntry,LCD_QUEUE_RS_BIT));
+
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
+			/* out the byte to the data bus D0 --> D7 then Enable LCD E=1 */
+			LCD_writeDataBus(data);
+			GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+			g_lcd_asyncState = LCD_ASYNC_LATCH_LAST ;
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+			/* out the higher 4 bits to the data bus then Enable LCD E=1 */
+			LCD_writeDataBus(data >> 4);
+			GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+			g_lcd_asyncState = LCD_ASYNC_LATCH_HIGH_NIBBLE ;
+#endif
+		}
+		break;
+	case LCD_ASYNC_LATCH_HIGH_NIBBLE :
+		/* Disable LCD E=0 */
+		GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+		g_lcd_asyncState = LCD_ASYNC_SETUP_LOW_NIBBLE ;
+		break;
+	case LCD_ASYNC_SETUP_LOW_NIBBLE :
+		/* out the lower 4 bits to the data bus then Enable LCD E=1 */
+		LCD_writeDataBus(data & 0x0F);
+		GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+		g_lcd_asyncState = LCD_ASYNC_LATCH_LAST ;
+		break;
+	case LCD_ASYNC_LATCH_LAST :
+		/* Disable LCD E=0 */
+		GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+
+#if(LCD_BUSY_FLAG_DISABLED == LCD_BUSY_FLAG_MODE)
+		/* Clear and return home commands need more time to be executed */
+		if((BIT_IS_CLEAR(g_lcd_asyncEntry,LCD_QUEUE_RS_BIT)) && ((data & 0xFC) == 0))
+		{
+			g_lcd_asyncWaitTicks = LCD_LONG_COMMAND_TICKS ;
+		}
+#endif
+
+		g_lcd_asyncState = LCD_ASYNC_IDLE ;
+		break;
+	}
+}
+#endif
+
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+/* Inputs: void.
+ *
+ * Return Value: The busy flag value LOGIC_HIGH or LOGIC_LOW.
+ *
+ * Description:
+ * 	Read the busy flag from DB7 with one instruction read cycle RS=0 and R/W=1,
+ * 	In 4-bits mode the second E pulse completes the read cycle of the lower 4 bits.
+ */
+static uint8 LCD_readBusyFlag(void)
+{
+	uint8 busy ;
+
+	/* Configure the data pins as input pins to read the LCD */
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
+	GPIO_STATIC_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID, PORT_INPUT);
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, PIN_INPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, PIN_INPUT);
+#endif
+
+	/* Instruction read RS=0 R/W=1 */
+	GPIO_STATIC_WRITE_PIN(LCD_RS_PORT_ID, LCD_RS_PIN_ID, LOGIC_LOW);
+	GPIO_STATIC_WRITE_PIN(LCD_RW_PORT_ID, LCD_RW_PIN_ID, LOGIC_HIGH);
+	/* delay for processing Tas = 50ns */
+	_delay_us(1);
+
+	/* Enable LCD E=1 then read DB7 after Tddr = 360ns */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	_delay_us(1);
+	busy = GPIO_STATIC_READ_PIN(LCD_DATA_PORT_ID, LCD_BUSY_FLAG_PIN_ID);
+
+	/* Disable LCD E=0 */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	_delay_us(1);
+
+#if(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+	/* Dummy read of the lower 4 bits */
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_HIGH);
+	_delay_us(1);
+	GPIO_STATIC_WRITE_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID, LOGIC_LOW);
+	_delay_us(1);
+#endif
+
+	/* Back to write mode R/W=0 and data pins as output pins */
+	GPIO_STATIC_WRITE_PIN(LCD_RW_PORT_ID, LCD_RW_PIN_ID, LOGIC_LOW);
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
+	GPIO_STATIC_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID, PORT_OUTPUT);
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN3_ID, PIN_OUTPUT);
+	GPIO_STATIC_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID, LCD_DATA_PIN4_ID, PIN_OUTPUT);
+#endif
+
+	return busy ;
 }
 
+#if(LCD_BLOCKING_BACKEND == LCD_BACKEND)
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Wait until the LCD finishes the execution of the previous byte.
+ * 	It gives up after LCD_BUSY_FLAG_TIMEOUT reads, so a missing screen can not hang the system.
+ */
+static void LCD_waitBusyFlag(void)
+{
+	uint16 count = 0 ;
+
+	while((LCD_readBusyFlag()) && (count < LCD_BUSY_FLAG_TIMEOUT))
+	{
+		count++ ;
+	}
+}
+#endif
+#endif
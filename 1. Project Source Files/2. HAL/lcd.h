@@ -16,6 +16,8 @@
 #include <stdlib.h>
 #include <util/delay.h>
 #include "gpio.h"
+#include "timer1.h"
+#include "uart.h"
 #include "std_types.h"
 #include "common_macros.h"
 
@@ -36,13 +38,48 @@
 
 #define LCD_DATA_BITS_MODE 			         (LCD_TWO_LINES_EIGHT_BITS_MODE)
 
-/* LCD HW Ports and Pins IDs */
+/* LCD Dimensions, 2x16 or 4x16 */
+#define LCD_ROWS							 2
+#define LCD_COLS							 16
+
+/* LCD Transfer Backends:
+ * 	1. Blocking backend sends each byte with fixed delays before returning.
+ * 	2. Asynchronous backend queues the bytes and sends them from the Timer1 compare B interrupt,
+ * 	   one bus phase each tick, the tick period should be longer than the interrupt execution time. */
+#define LCD_BLOCKING_BACKEND				 0
+#define LCD_ASYNC_BACKEND					 1
+
+#define LCD_BACKEND							 (LCD_ASYNC_BACKEND)
+
+#define LCD_ASYNC_TICK_US					 200
+#define LCD_ASYNC_QUEUE_SIZE				 64		/* must be a power of two and not more than 128 */
+
+/* Execution time of the clear and return home commands, other commands need 40us */
+#define LCD_LONG_COMMAND_US					 1640
+
+/* LCD Busy Flag Modes:
+ * 	1. Disabled: R/W pin is connected to the ground and each transfer waits the worst case time.
+ * 	2. Enabled : R/W pin is connected to the MCU and each transfer waits until the busy flag DB7 is cleared. */
+#define LCD_BUSY_FLAG_DISABLED				 0
+#define LCD_BUSY_FLAG_ENABLED				 1
+
+#define LCD_BUSY_FLAG_MODE					 (LCD_BUSY_FLAG_DISABLED)
+
+/* Maximum number of busy flag reads before the transfer continues anyway */
+#define LCD_BUSY_FLAG_TIMEOUT				 1000
+
+/* LCD HW Ports and Pins IDs, PD0 and PD1 are the USART RXD and TXD pins */
 #define LCD_RS_PORT_ID                 		 PORTD_ID
-#define LCD_RS_PIN_ID                        PIN0_ID
+#define LCD_RS_PIN_ID                        PIN3_ID
 
 #define LCD_E_PORT_ID                        PORTD_ID
 #define LCD_E_PIN_ID                         PIN2_ID
 
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+#define LCD_RW_PORT_ID                       PORTD_ID
+#define LCD_RW_PIN_ID                        PIN4_ID
+#endif
+
 #if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
 #define LCD_DATA_PORT_ID                     PORTC_ID
 #elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
@@ -52,6 +89,40 @@
 #define LCD_DATA_PIN2_ID			         PIN4_ID
 #define LCD_DATA_PIN3_ID 			         PIN5_ID
 #define LCD_DATA_PIN4_ID			         PIN6_ID
+
+/* The 4 data pins are written together as one group, so they must be adjacent */
+#if (LCD_DATA_PIN2_ID != (LCD_DATA_PIN1_ID + 1)) || (LCD_DATA_PIN3_ID != (LCD_DATA_PIN1_ID + 2)) || \
+	(LCD_DATA_PIN4_ID != (LCD_DATA_PIN1_ID + 3))
+#error "LCD data pins should be adjacent pins in 4-bits mode"
+#endif
+#endif
+
+/* The telemetry UART takes RXD and TXD pins, an LCD pin on them stops the LCD after UART_init */
+#define LCD_PIN_IS_UART_PIN(port, pin)		 (((port) == UART_PORT_ID) && (((pin) == UART_RXD_PIN_ID) || ((pin) == UART_TXD_PIN_ID)))
+
+#if LCD_PIN_IS_UART_PIN(LCD_RS_PORT_ID, LCD_RS_PIN_ID) || LCD_PIN_IS_UART_PIN(LCD_E_PORT_ID, LCD_E_PIN_ID)
+#error "LCD RS and E pins can not be the USART RXD or TXD pins"
+#endif
+
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+#if LCD_PIN_IS_UART_PIN(LCD_RW_PORT_ID, LCD_RW_PIN_ID)
+#error "LCD R/W pin can not be the USART RXD or TXD pins"
+#endif
+#endif
+
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE) && (LCD_DATA_PORT_ID == UART_PORT_ID)
+#error "LCD data port can not be the USART port in 8-bits mode"
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+#if LCD_PIN_IS_UART_PIN(LCD_DATA_PORT_ID, LCD_DATA_PIN1_ID) || LCD_PIN_IS_UART_PIN(LCD_DATA_PORT_ID, LCD_DATA_PIN2_ID)
+#error "LCD data pins can not be the USART RXD or TXD pins"
+#endif
+#endif
+
+/* The busy flag is read on DB7 */
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
+#define LCD_BUSY_FLAG_PIN_ID				 PIN7_ID
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+#define LCD_BUSY_FLAG_PIN_ID				 LCD_DATA_PIN4_ID
 #endif
 
 /****************************************************************************
@@ -75,7 +146,9 @@ void LCD_init(void);
  * Return Value: void.
  *
  * Description:
- * 	Send the required command to the screen
+ * 	Send the required command to the screen.
+ * 	In asynchronous backend the command is queued, it waits only if the queue is full.
+ * 	If the interrupts are disabled while the queue is full, the bus phases are done by polling.
  */
 void LCD_sendCommand(uint8 command);
 
@@ -85,7 +158,8 @@ void LCD_sendCommand(uint8 command);
  * Return Value: void.
  *
  * Description:
- * 	Display the required character on the screen.
+ * 	Write the required character in the screen shadow at the current cursor position
+ * 	then move the cursor to the next column, it will be displayed by LCD_flush.
  */
 void LCD_displayCharacter(uint8 data);
 
@@ -95,7 +169,7 @@ void LCD_displayCharacter(uint8 data);
  * Return Value: void.
  *
  * Description:
- * 	Display the required string on the screen.
+ * 	Write the required string in the screen shadow at the current cursor position.
  */
 void LCD_displayString(const char *Str);
 
@@ -106,7 +180,7 @@ void LCD_displayString(const char *Str);
  * Return Value: void.
  *
  * Description:
- * 	Move the cursor to a specified row and column index on the screen.
+ * 	Move the shadow cursor to a specified row and column index on the screen.
  */
 void LCD_moveCursor(uint8 row, uint8 col);
 
@@ -118,7 +192,7 @@ void LCD_moveCursor(uint8 row, uint8 col);
  * Return Value: void.
  *
  * Description:
- * 	Display the required string in a specified row and column index on the screen.
+ * 	Write the required string in the screen shadow in a specified row and column index.
  */
 void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str);
 
@@ -127,7 +201,7 @@ void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str);
  * Return Value: void.
  *
  * Description:
- * 	Send the clear screen command.
+ * 	Clear the screen shadow by filling it with spaces.
  */
 void LCD_clearScreen(void);
 
@@ -137,9 +211,28 @@ void LCD_clearScreen(void);
  * Return Value: void.
  *
  * Description:
- * 	Display the required decimal value on the screen
+ * 	Write the required decimal value in the screen shadow.
  */
 void LCD_integerToString(int data);
 
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Send to the screen only the shadow cells which differ from the screen content.
+ * 	Adjacent changed cells in the same row are sent after a single cursor move command.
+ */
+void LCD_flush(void);
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE if all the queued bytes are sent to the screen, otherwise FALSE.
+ *
+ * Description:
+ * 	Check the progress of the asynchronous backend, the blocking backend is always idle.
+ */
+boolean LCD_isIdle(void);
+
 
 #endif /* LCD_H_ */
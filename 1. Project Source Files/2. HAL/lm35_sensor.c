@@ -10,28 +10,245 @@
 /****************************************************************************
  * 								  Includes								    *
  ****************************************************************************/
+#include <avr/eeprom.h>
 #include "lm35_sensor.h"
+#include "eeprom.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define LM35_SENSOR_CHANNEL(channel)		(channel),
+#define LM35_SENSOR_DEGREE_SCALE(channel)	LM35_INPUT_DEGREE_SCALE(channel),
+#define LM35_SENSOR_DECI_DEGREE_SCALE(channel)	(LM35_INPUT_DECI_DEGREE_SCALE(channel) + LM35_SCALE_CHECK(channel)),
+#define LM35_SENSOR_OFFSET(channel)			LM35_INPUT_OFFSET_DC(channel),
+
+/* The calibration multiplies a scale by the bandgap value in 32 bits, the compilation stops if it can overflow.
+ * The deci-degree scale is the largest one, up to the maximum bandgap value accepted by LM35_Calibrate. */
+#define LM35_SCALE_CHECK(channel)			STATIC_CHECK_ZERO(((uint64)LM35_INPUT_DECI_DEGREE_SCALE(channel) * LM35_BANDGAP_MAX_VALUE) < 0xFFFFFFFFUL)
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static const uint8 g_lm35_channels[LM35_NUM_OF_SENSORS] = { LM35_SENSORS(LM35_SENSOR_CHANNEL) } ;
+
+/* Nominal scale factors and temperature at ZERO ADC value of each sensor input */
+static const uint32 g_lm35_nominalDegreeScales[LM35_NUM_OF_SENSORS] = { LM35_SENSORS(LM35_SENSOR_DEGREE_SCALE) } ;
+static const uint32 g_lm35_nominalDeciDegreeScales[LM35_NUM_OF_SENSORS] = { LM35_SENSORS(LM35_SENSOR_DECI_DEGREE_SCALE) } ;
+static const sint16 g_lm35_offsets_dC[LM35_NUM_OF_SENSORS] = { LM35_SENSORS(LM35_SENSOR_OFFSET) } ;
+
+/* Scale factors corrected with the measured reference and the bandgap value of the correction */
+static uint32 g_lm35_degreeScales[LM35_NUM_OF_SENSORS] = { LM35_SENSORS(LM35_SENSOR_DEGREE_SCALE) } ;
+static uint32 g_lm35_deciDegreeScales[LM35_NUM_OF_SENSORS] = { LM35_SENSORS(LM35_SENSOR_DECI_DEGREE_SCALE) } ;
+static uint16 g_lm35_bandgapValue = ADC_BANDGAP_NOMINAL_VALUE ;
+
+/* Copy of the calibration saved in the EEPROM, so it is never read while the EEPROM driver writes it */
+static uint16 g_lm35_savedValue ;
+static boolean g_lm35_savedValid = FALSE ;
+
+/****************************************************************************
+ * 						  Private Functions Prototypes					    *
+ ****************************************************************************/
+static void LM35_applyCalibration(uint16 bandgap_value);
 
 /****************************************************************************
  * 							Functions Definitions						    *
  ****************************************************************************/
 
 /* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ *	Function responsible for load the reference calibration saved in the EEPROM, it should be called once
+ *	before the EEPROM driver starts writing. The nominal scale factors are used if the EEPROM has no valid calibration.
+ */
+void LM35_Init(void)
+{
+	uint16 bandgap_value ;
+	uint16 check_value ;
+
+	bandgap_value = eeprom_read_word((const uint16_t *)LM35_CALIBRATION_EEPROM_ADDRESS) ;
+	check_value = eeprom_read_word((const uint16_t *)(LM35_CALIBRATION_EEPROM_ADDRESS + 2)) ;
+
+	g_lm35_savedValue = bandgap_value ;
+	g_lm35_savedValid = (0xFFFF == (bandgap_value ^ check_value)) ? TRUE : FALSE ;
+
+	if((TRUE == g_lm35_savedValid) &&
+	   (bandgap_value >= LM35_BANDGAP_MIN_VALUE) && (bandgap_value <= LM35_BANDGAP_MAX_VALUE))
+	{
+		LM35_applyCalibration(bandgap_value);
+	}
+	else
+	{
+		LM35_applyCalibration(ADC_BANDGAP_NOMINAL_VALUE);
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE if the bandgap measurement is used, FALSE if it is not ready or out of the range.
+ *
+ * Description:
+ *	Function responsible for correct the scale factors with the measured ADC reference, it should be called periodically.
+ *	The correction is part of the fixed point scale factors, so the temperature conversion has no extra cost.
+ *	The new measurement is saved in the EEPROM if it moves by more than LM35_CALIBRATION_HYSTERESIS,
+ *	the EEPROM driver writes it in the background. If the last one is still being written it is saved in a later call.
+ */
+boolean LM35_Calibrate(void)
+{
+	boolean valid = FALSE ;
+	uint16 bandgap_value = ADC_readBandgap() ;
+	uint8 calibration[4] ;
+
+	if((bandgap_value >= LM35_BANDGAP_MIN_VALUE) && (bandgap_value <= LM35_BANDGAP_MAX_VALUE))
+	{
+		valid = TRUE ;
+
+		if(((FALSE == g_lm35_savedValid) ||
+		    (bandgap_value > (g_lm35_savedValue + LM35_CALIBRATION_HYSTERESIS)) ||
+		    ((bandgap_value + LM35_CALIBRATION_HYSTERESIS) < g_lm35_savedValue)) &&
+		   (FALSE == EEPROM_isBusy()))
+		{
+			/* The value then its complement, in the little endian order of eeprom_read_word */
+			calibration[0] = (uint8)bandgap_value ;
+			calibration[1] = (uint8)(bandgap_value >> 8) ;
+			calibration[2] = (uint8)~calibration[0] ;
+			calibration[3] = (uint8)~calibration[1] ;
+
+			if(EEPROM_write(LM35_CALIBRATION_EEPROM_ADDRESS, calibration, sizeof(calibration)))
+			{
+				g_lm35_savedValue = bandgap_value ;
+				g_lm35_savedValid = TRUE ;
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+
+		if(bandgap_value != g_lm35_bandgapValue)
+		{
+			LM35_applyCalibration(bandgap_value);
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return valid ;
+}
+
+/* Inputs:
+ * 	1. sensor: The sensor index, it should be less than LM35_NUM_OF_SENSORS.
  *
  * Return Value: Temperature value from the LM35 sensor.
  *
  * Description:
  *	Function responsible for calculate the temperature from the ADC digital value.
+ *	The conversion uses a fixed point scale factor, so no floating point is needed.
+ *	If the sensor index is not correct, The function will return ZERO value.
  */
-uint8 LM35_GetTemperature(void)
+uint8 LM35_GetTemperature(uint8 sensor)
 {
 	uint8 temp_value = 0 ;
+	sint16 adc_value ;
+	sint32 temperature ;
+
+	if(sensor < LM35_NUM_OF_SENSORS)
+	{
+		/* A differential value is signed, it is negative below the reference pin voltage */
+		adc_value = (sint16)ADC_readChannel(g_lm35_channels[sensor]) ;
+
+		temperature = (((sint32)adc_value * (sint32)g_lm35_degreeScales[sensor]) >> LM35_SCALE_SHIFT) + (g_lm35_offsets_dC[sensor] / 10) ;
+		temp_value = (temperature > 0) ? (uint8)temperature : 0 ;
+	}
+
+	return temp_value ;
+}
 
-	uint16 adc_value = ADC_readChannel(SENSOR_CHANNEL_ID) ;
+/* Inputs:
+ * 	1. sensor: The sensor index, it should be less than LM35_NUM_OF_SENSORS.
+ *
+ * Return Value: Temperature value from the LM35 sensor in tenths of degree Celsius.
+ *
+ * Description:
+ *	Function responsible for calculate the temperature from the oversampled ADC value
+ *	with 0.1 degree resolution using integer arithmetic only.
+ *	If the sensor index is not correct, The function will return ZERO value.
+ */
+uint16 LM35_GetTemperature_dC(uint8 sensor)
+{
+	uint16 temp_value = 0 ;
+	sint16 adc_value ;
+	sint32 temperature ;
+
+	if(sensor < LM35_NUM_OF_SENSORS)
+	{
+		adc_value = (sint16)ADC_readOversampled(g_lm35_channels[sensor], LM35_OVERSAMPLING_BITS) ;
 
-	temp_value = (uint8)(((uint32)adc_value*SENSOR_MAX_TEMP_VALUE*ADC_REF_VOLT_VALUE)/(ADC_MAXIMUM_VALUE*SENSOR_MAX_VOLT_VALUE));
+		/* Each extra bit halves the ADC step */
+		temperature = (((sint32)adc_value * (sint32)g_lm35_deciDegreeScales[sensor]) >> (LM35_SCALE_SHIFT + LM35_OVERSAMPLING_BITS))
+					  + g_lm35_offsets_dC[sensor] ;
+		temp_value = (temperature > 0) ? (uint16)temperature : 0 ;
+	}
 
 	return temp_value ;
 }
 
+/* Inputs:
+ * 	1. sensor: The sensor index, it should be less than LM35_NUM_OF_SENSORS.
+ *
+ * Return Value: The last ADC digital value of the sensor channel.
+ *
+ * Description:
+ *	Function responsible for read the raw ADC value, it is used for the sensor logging.
+ *	If the sensor index is not correct, The function will return ZERO value.
+ */
+uint16 LM35_GetAdcValue(uint8 sensor)
+{
+	uint16 adc_value = 0 ;
+
+	if(sensor < LM35_NUM_OF_SENSORS)
+	{
+		adc_value = ADC_readChannel(g_lm35_channels[sensor]) ;
+	}
+
+	return adc_value ;
+}
+
+/****************************************************************************
+ * 						   Private Functions Definitions				    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. bandgap_value: The bandgap ADC value measured with the reference.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ *	Function responsible for compute the scale factors for the measured reference.
+ *	A reference below 2.56V gives a bandgap value above the nominal one, so each ADC step is less volts.
+ */
+static void LM35_applyCalibration(uint16 bandgap_value)
+{
+	uint8 sensor ;
 
+	g_lm35_bandgapValue = bandgap_value ;
+	for(sensor = 0 ; sensor < LM35_NUM_OF_SENSORS ; sensor++)
+	{
+		/* The products fit in 32 bits (LM35_SCALE_CHECK), so no 64-bit division is needed at run time */
+		g_lm35_degreeScales[sensor] = ((g_lm35_nominalDegreeScales[sensor] * ADC_BANDGAP_NOMINAL_VALUE)
+										+ (bandgap_value / 2)) / bandgap_value ;
+		g_lm35_deciDegreeScales[sensor] = ((g_lm35_nominalDeciDegreeScales[sensor] * ADC_BANDGAP_NOMINAL_VALUE)
+										+ (bandgap_value / 2)) / bandgap_value ;
+	}
+}
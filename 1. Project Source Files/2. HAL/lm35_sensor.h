@@ -21,7 +21,48 @@
  ****************************************************************************/
 
 #define SENSOR_MAX_TEMP_VALUE 		150
-#define	SENSOR_MAX_VOLT_VALUE 		1.5
+#define	SENSOR_MAX_VOLT_MV	 		1500
+
+/* Conversion scale factors from ADC value to temperature in Q16 fixed point, computed at compile time:
+ * temperature = ADC value * (SENSOR_MAX_TEMP_VALUE * ADC_REF_VOLT) / (ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT) */
+#define LM35_SCALE_SHIFT			16
+#define LM35_SCALE_DENOMINATOR		((uint64)ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_MV)
+
+/* Degree Celsius per ADC step */
+#define LM35_DEGREE_SCALE			((uint32)(((((uint64)SENSOR_MAX_TEMP_VALUE * ADC_REF_VOLT_MV) << LM35_SCALE_SHIFT) \
+										+ (LM35_SCALE_DENOMINATOR / 2)) / LM35_SCALE_DENOMINATOR))
+
+/* Tenth of degree Celsius per ADC step */
+#define LM35_DECI_DEGREE_SCALE		((uint32)(((((uint64)SENSOR_MAX_TEMP_VALUE * 10 * ADC_REF_VOLT_MV) << LM35_SCALE_SHIFT) \
+										+ (LM35_SCALE_DENOMINATOR / 2)) / LM35_SCALE_DENOMINATOR))
+
+/* A differential input has 512 steps for the reference divided by the gain, from its reference pin voltage */
+#define LM35_DIFF_SCALE_DENOMINATOR(channel)	((uint64)512 * ADC_INPUT_GAIN(channel) * SENSOR_MAX_VOLT_MV)
+#define LM35_DIFF_SCALE(units, channel)		((uint32)(((((uint64)SENSOR_MAX_TEMP_VALUE * (units) * ADC_REF_VOLT_MV) << LM35_SCALE_SHIFT) \
+										+ (LM35_DIFF_SCALE_DENOMINATOR(channel) / 2)) / LM35_DIFF_SCALE_DENOMINATOR(channel)))
+
+/* Scale factors and temperature offset in deci-degrees of a sensor input */
+#define LM35_INPUT_DEGREE_SCALE(channel)		(ADC_INPUT_IS_DIFFERENTIAL(channel) ? LM35_DIFF_SCALE(1, channel) : LM35_DEGREE_SCALE)
+#define LM35_INPUT_DECI_DEGREE_SCALE(channel)	(ADC_INPUT_IS_DIFFERENTIAL(channel) ? LM35_DIFF_SCALE(10, channel) : LM35_DECI_DEGREE_SCALE)
+#define LM35_INPUT_OFFSET_DC(channel)			(ADC_INPUT_IS_DIFFERENTIAL(channel) ? \
+												 ((LM35_REFERENCE_MV * SENSOR_MAX_TEMP_VALUE * 10) / SENSOR_MAX_VOLT_MV) : 0)
+
+/* Extra ADC bits of the deci-degree reading, 2 bits give about 0.06 C steps instead of 0.25 C */
+#define LM35_OVERSAMPLING_BITS		2
+
+/* Reference calibration: the scale factors are multiplied by ADC_BANDGAP_NOMINAL_VALUE / measured bandgap value.
+ * A measurement out of +/-15% of the nominal value is wrong and it is not used. */
+#define LM35_BANDGAP_MIN_VALUE		((ADC_BANDGAP_NOMINAL_VALUE * 85) / 100)
+#define LM35_BANDGAP_MAX_VALUE		((ADC_BANDGAP_NOMINAL_VALUE * 115) / 100)
+
+/* The measured bandgap value is saved in the EEPROM followed by its complement, so an erased EEPROM is not used.
+ * It is written again only if the new measurement moves by more than the hysteresis, to save the EEPROM cycles. */
+#define LM35_CALIBRATION_EEPROM_ADDRESS	0x0000
+#define LM35_CALIBRATION_HYSTERESIS		2
+
+#if (LM35_OVERSAMPLING_BITS > ADC_OVERSAMPLING_MAX_BITS)
+#error "LM35_OVERSAMPLING_BITS is more than the ADC driver oversampling"
+#endif
 
 #define ADC0 			    		0
 #define ADC1 			     		1
@@ -32,20 +73,105 @@
 #define ADC6 			     		6
 #define ADC7 			     		7
 
+/* LM35 wiring: each LM35 on a single ended input, or each LM35 against a reference pin with the 10x gain.
+ * The differential wiring has the LM35 of zone 0 on ADC1 and the one of zone 1 on ADC3,
+ * with a LM35_REFERENCE_MV divider on ADC0 and ADC2. Its step is 0.5 mV (0.05 C) instead of 2.5 mV (0.25 C)
+ * but it measures only LM35_REFERENCE_MV +/- 256 mV, 4.4 C to 55.6 C with 300 mV.
+ * The differential inputs are tested by Atmel in the TQFP and MLF packages only. */
+#define LM35_SINGLE_ENDED_INPUTS	0
+#define LM35_DIFFERENTIAL_INPUTS	1
+
+#define LM35_INPUTS_MODE			(LM35_SINGLE_ENDED_INPUTS)
+
+#define LM35_REFERENCE_MV			300
+
+#if (LM35_SINGLE_ENDED_INPUTS == LM35_INPUTS_MODE)
+/* Sensor of the first zone */
 #define SENSOR_CHANNEL_ID			(ADC2)
 
+/* LM35_SENSOR(channel): ADC channel of each sensor, sensor n measures the temperature of zone n */
+#define LM35_SENSORS(LM35_SENSOR) \
+	LM35_SENSOR(SENSOR_CHANNEL_ID) \
+	LM35_SENSOR(ADC3)
+#else
+#define SENSOR_CHANNEL_ID			(ADC_DIFF_ADC1_ADC0_X10)
+
+#define LM35_SENSORS(LM35_SENSOR) \
+	LM35_SENSOR(SENSOR_CHANNEL_ID) \
+	LM35_SENSOR(ADC_DIFF_ADC3_ADC2_X10)
+#endif
+
+#define LM35_COUNT_SENSOR(channel)		+ 1
+#define LM35_CHANNEL_BIT(channel)		| (ADC_INPUT_IS_DIFFERENTIAL(channel) ? 0 : (1<<(channel)))
+
+/* Scan list entries of the sensors, the gain stage settles during a dropped conversion */
+#define LM35_SCAN_ENTRY(channel)		{(channel), ADC_INPUT_IS_DIFFERENTIAL(channel)},
+
+#define LM35_NUM_OF_SENSORS			(0 LM35_SENSORS(LM35_COUNT_SENSOR))
+
+/* Single ended ADC channels of the sensors, for a driver without a scan list */
+#define LM35_CHANNELS_MASK			(0 LM35_SENSORS(LM35_CHANNEL_BIT))
+
 /****************************************************************************
  * 							Functions Prototypes						    *
  ****************************************************************************/
 
 /* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ *	Function responsible for load the reference calibration saved in the EEPROM, it should be called once
+ *	before the EEPROM driver starts writing. The nominal scale factors are used if the EEPROM has no valid calibration.
+ */
+void LM35_Init(void);
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE if the bandgap measurement is used, FALSE if it is not ready or out of the range.
+ *
+ * Description:
+ *	Function responsible for correct the scale factors with the measured ADC reference, it should be called periodically.
+ *	The correction is part of the fixed point scale factors, so the temperature conversion has no extra cost.
+ *	The new measurement is saved in the EEPROM if it moves by more than LM35_CALIBRATION_HYSTERESIS,
+ *	the EEPROM driver writes it in the background. If the last one is still being written it is saved in a later call.
+ */
+boolean LM35_Calibrate(void);
+
+/* Inputs:
+ * 	1. sensor: The sensor index, it should be less than LM35_NUM_OF_SENSORS.
  *
  * Return Value: Temperature value from the LM35 sensor.
  *
  * Description:
  *	Function responsible for calculate the temperature from the ADC digital value.
+ *	The conversion uses a fixed point scale factor, so no floating point is needed.
+ *	If the sensor index is not correct, The function will return ZERO value.
+ */
+uint8 LM35_GetTemperature(uint8 sensor);
+
+/* Inputs:
+ * 	1. sensor: The sensor index, it should be less than LM35_NUM_OF_SENSORS.
+ *
+ * Return Value: Temperature value from the LM35 sensor in tenths of degree Celsius.
+ *
+ * Description:
+ *	Function responsible for calculate the temperature from the oversampled ADC value
+ *	with 0.1 degree resolution using integer arithmetic only.
+ *	If the sensor index is not correct, The function will return ZERO value.
+ */
+uint16 LM35_GetTemperature_dC(uint8 sensor);
+
+/* Inputs:
+ * 	1. sensor: The sensor index, it should be less than LM35_NUM_OF_SENSORS.
+ *
+ * Return Value: The last ADC digital value of the sensor channel.
+ *
+ * Description:
+ *	Function responsible for read the raw ADC value, it is used for the sensor logging.
+ *	If the sensor index is not correct, The function will return ZERO value.
  */
-uint8 LM35_GetTemperature(void);
+uint16 LM35_GetAdcValue(uint8 sensor);
 
 
 
@@ -10,7 +10,165 @@
 /****************************************************************************
  * 								  Includes								    *
  ****************************************************************************/
+#include <avr/interrupt.h>
 #include "adc.h"
+#include "power.h"
+
+#if (ADC_SAMPLES_BUFFER_SIZE & (ADC_SAMPLES_BUFFER_SIZE - 1)) || (ADC_SAMPLES_BUFFER_SIZE > 128)
+#error "ADC_SAMPLES_BUFFER_SIZE must be a power of two and not more than 128"
+#endif
+
+#if (ADC_SAMPLES_BUFFER_SIZE < (2 * ADC_OVERSAMPLING_SAMPLES(ADC_OVERSAMPLING_MAX_BITS)))
+#error "ADC_SAMPLES_BUFFER_SIZE must keep twice the oversampling samples, so the ISR can store while they are summed"
+#endif
+
+#if ((F_CPU >> 7) > ADC_CLOCK_MAX_HZ) || ((F_CPU >> 1) < ADC_CLOCK_MIN_HZ)
+#error "No ADC prescaler gives an ADC clock in the range with this F_CPU"
+#endif
+
+#if (ADC_BANDGAP_SCAN_PERIOD > 255) || (ADC_BANDGAP_SCAN_PERIOD < 1)
+#error "ADC_BANDGAP_SCAN_PERIOD must be from 1 to 255"
+#endif
+
+#if (ADC_OVERSAMPLING_MAX_BITS > 3)
+#error "The oversampling sum of 4^ADC_OVERSAMPLING_MAX_BITS samples must fit in 16 bits"
+#endif
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The last bandgap result is read while the ISR writes the other one */
+#define ADC_BANDGAP_BUFFER_SIZE			2
+
+/* Scan step: the scan list index, with this flag the conversion is only for settling and its result is dropped */
+#define ADC_SCAN_DISCARD_STEP			0x80
+
+/* Scan step of the bandgap measurement, it is inserted between two scans */
+#define ADC_SCAN_BANDGAP_STEP			0x40
+#define ADC_SCAN_INDEX_MASK				0x3F
+
+/* Free running mode storage: each different input of the scan list has its own slot */
+#define ADC_NUM_OF_SLOTS				ADC_SCAN_MAX_ENTRIES
+#define ADC_NO_SLOT						0xFF
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static ADC_OperationMode g_adc_mode = ADC_POLLING_MODE ;
+
+/* Polling mode: set by the ADC ISR which wakes up the CPU at the end of the conversion */
+static volatile boolean g_adc_conversionDone = FALSE ;
+
+/* Free running mode: the scan list and the conversion pipeline state.
+ * Without a trigger source the conversion which completes in the ISR was started with the step written one ISR before,
+ * because the next conversion starts automatically before the ISR can change ADMUX.
+ * With a trigger source the next conversion starts after the ISR, so the pending step is not used. */
+static ADC_ScanEntryType g_adc_scanList[ADC_SCAN_MAX_ENTRIES] ;
+static uint8 g_adc_scanSlots[ADC_SCAN_MAX_ENTRIES] ;
+static uint8 g_adc_scanLength = 0 ;
+static volatile uint8 g_adc_convertingStep = 0 ;
+static volatile uint8 g_adc_pendingStep = 0 ;
+
+/* The Timer0 flag of the trigger source, the ADC starts on its rising edge so the ADC ISR clears it */
+static uint8 g_adc_triggerFlag = 0 ;
+
+/* The ISR fills the scan values of the generation parity, the other half holds the last complete scan.
+ * The end of the scan only increments the generation, the readers copy the values. */
+static volatile uint16 g_adc_scanValues[2][ADC_SCAN_MAX_ENTRIES] ;
+static volatile uint8 g_adc_generation = 0 ;
+
+/* Complete scans since ADC_init, it stops at 255, the oversampling waits for enough samples */
+static volatile uint8 g_adc_scans = 0 ;
+
+/* Free running mode bandgap measurement: the scans since the last one and the last results */
+static uint8 g_adc_bandgapScans = 0 ;
+static volatile uint16 g_adc_bandgapValues[ADC_BANDGAP_BUFFER_SIZE] ;
+static volatile uint8 g_adc_bandgapHead = 0 ;
+static volatile boolean g_adc_bandgapReady = FALSE ;
+
+/* The slot of each MUX4:0 input, ADC_NO_SLOT if it is not in the scan list */
+static uint8 g_adc_inputSlots[ADC_NUM_OF_INPUTS] ;
+
+/* Sample history per slot, the ISR stores the raw sample at the head then increments it.
+ * Nothing is consumed, the readers sum the newest samples and read again if the ISR overwrote them.
+ * The 8-bit head is read in one instruction, it wraps together with the power of two index. */
+static volatile uint16 g_adc_samples[ADC_NUM_OF_SLOTS][ADC_SAMPLES_BUFFER_SIZE] ;
+static volatile uint8 g_adc_heads[ADC_NUM_OF_SLOTS] ;
+
+/****************************************************************************
+ * 						  Private Functions Prototypes					    *
+ ****************************************************************************/
+static uint8 ADC_nextStep(uint8 step);
+static uint8 ADC_stepMux(uint8 step);
+static uint16 ADC_convert(uint8 mux);
+static uint16 ADC_sumNewest(const volatile uint16 *samples_ptr, const volatile uint8 *head_ptr, uint8 size, uint8 count, uint8 mux);
+
+/****************************************************************************
+ * 						   Interrupt Service Routines					    *
+ ****************************************************************************/
+ISR(ADC_vect)
+{
+	uint16 sample ;
+	uint8 step ;
+	uint8 slot ;
+
+	if(ADC_POLLING_MODE == g_adc_mode)
+	{
+		/* The result stays in the ADC register, ADC_readChannel reads it after waking up */
+		g_adc_conversionDone = TRUE ;
+	}
+	else
+	{
+		sample = ADC ;
+		step = g_adc_convertingStep ;
+
+		if(step & ADC_SCAN_DISCARD_STEP)
+		{
+			/* Do Nothing. */
+		}
+		else if(step & ADC_SCAN_BANDGAP_STEP)
+		{
+			g_adc_bandgapValues[g_adc_bandgapHead & (ADC_BANDGAP_BUFFER_SIZE - 1)] = sample ;
+			g_adc_bandgapHead++ ;
+			g_adc_bandgapReady = TRUE ;
+		}
+		else
+		{
+			/* Only the raw sample is stored, the sign extension and the sums are done by the readers */
+			slot = g_adc_scanSlots[step] ;
+			g_adc_samples[slot][g_adc_heads[slot] & (ADC_SAMPLES_BUFFER_SIZE - 1)] = sample ;
+			g_adc_heads[slot]++ ;
+			g_adc_scanValues[g_adc_generation & 1][step] = sample ;
+
+			if(step == (g_adc_scanLength - 1))
+			{
+				/* Publish the complete scan, the next one is written in the other half */
+				g_adc_generation++ ;
+				g_adc_scans += (g_adc_scans < 0xFF) ? 1 : 0 ;
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+		}
+
+		if(g_adc_triggerFlag != 0)
+		{
+			/* The next trigger starts the next step, the flag is cleared to let its next event start a conversion */
+			g_adc_convertingStep = ADC_nextStep(step) ;
+			ADMUX = ( ADMUX & 0xE0 ) | ADC_stepMux(g_adc_convertingStep) ;
+			TIFR = g_adc_triggerFlag ;
+		}
+		else
+		{
+			/* The conversion already running uses the pending step, select the one after it */
+			g_adc_convertingStep = g_adc_pendingStep ;
+			g_adc_pendingStep = ADC_nextStep(g_adc_pendingStep) ;
+			ADMUX = ( ADMUX & 0xE0 ) | ADC_stepMux(g_adc_pendingStep) ;
+		}
+	}
+}
 
 /****************************************************************************
  * 							Functions Definitions						    *
@@ -23,9 +181,28 @@
  *
  * Description:
  * 	Function responsible for initialize the ADC driver.
+ * 	In free running mode the ADC ISR steps through the scan list, it switches ADMUX while the next
+ * 	conversion runs, so the channels are sampled back to back without waiting.
+ * 	With a trigger source a conversion starts at each trigger event, so each sample is taken at the same
+ * 	phase of the PWM period without the CPU, Timer0 must be started by the PWM driver.
  */
 void ADC_init(const ADC_ConfigType * Config_Ptr)
 {
+	uint8 channel ;
+	uint8 index ;
+	uint8 slots = 0 ;
+
+	for(index = 0 ; index < ADC_NUM_OF_SLOTS ; index++)
+	{
+		g_adc_heads[index] = 0 ;
+	}
+	for(index = 0 ; index < ADC_NUM_OF_INPUTS ; index++)
+	{
+		g_adc_inputSlots[index] = ADC_NO_SLOT ;
+	}
+	g_adc_bandgapHead = 0 ;
+	g_adc_bandgapReady = FALSE ;
+
 	switch(Config_Ptr->ref_volt)
 	{
 	case AREF :
@@ -65,28 +242,450 @@ void ADC_init(const ADC_ConfigType * Config_Ptr)
 		ADCSRA = ( ADCSRA & 0xF8 ) | F_CPU_128 ;
 		break;
 	}
+
+	g_adc_mode = Config_Ptr->mode ;
+
+	/* The scan list is given or it is made from the channels mask in the channels order */
+	g_adc_scanLength = 0 ;
+	g_adc_generation = 0 ;
+	g_adc_scans = 0 ;
+	if(Config_Ptr->scan_list != NULL_PTR)
+	{
+		for(index = 0 ; (index < Config_Ptr->scan_length) && (index < ADC_SCAN_MAX_ENTRIES) ; index++)
+		{
+			g_adc_scanList[index].channel = Config_Ptr->scan_list[index].channel & (ADC_NUM_OF_INPUTS - 1) ;
+			g_adc_scanList[index].discard_first = Config_Ptr->scan_list[index].discard_first ;
+		}
+		g_adc_scanLength = index ;
+	}
+	else
+	{
+		for(channel = 0 ; channel < ADC_NUM_OF_CHANNELS ; channel++)
+		{
+			if(BIT_IS_SET(Config_Ptr->channels_mask, channel))
+			{
+				g_adc_scanList[g_adc_scanLength].channel = channel ;
+				g_adc_scanList[g_adc_scanLength].discard_first = FALSE ;
+				g_adc_scanLength++ ;
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+		}
+	}
+	for(index = 0 ; index < g_adc_scanLength ; index++)
+	{
+		g_adc_scanValues[0][index] = 0 ;
+		g_adc_scanValues[1][index] = 0 ;
+
+		/* An input listed more than once shares the slot of its first entry */
+		channel = g_adc_scanList[index].channel ;
+		if(ADC_NO_SLOT == g_adc_inputSlots[channel])
+		{
+			g_adc_inputSlots[channel] = slots++ ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+		g_adc_scanSlots[index] = g_adc_inputSlots[channel] ;
+	}
+
+	if((ADC_FREE_RUNNING_MODE == Config_Ptr->mode) && (g_adc_scanLength != 0))
+	{
+		/* The first conversion after enabling the ADC is dropped, the second one uses the same ADMUX */
+		g_adc_convertingStep = 0 | ADC_SCAN_DISCARD_STEP ;
+		g_adc_pendingStep = 0 ;
+		ADMUX = ( ADMUX & 0xE0 ) | g_adc_scanList[0].channel ;
+
+		/* The bandgap is measured after the first scan, so the reference is calibrated soon after the start */
+		g_adc_bandgapScans = ADC_BANDGAP_SCAN_PERIOD - 1 ;
+
+		/* Auto trigger source in ADTS2:0 */
+		SFIOR = ( SFIOR & 0x1F ) | ( Config_Ptr->trigger_source << ADTS0 ) ;
+
+		switch(Config_Ptr->trigger_source)
+		{
+		case ADC_TRIGGER_FREE_RUNNING :
+			g_adc_triggerFlag = 0 ;
+
+			/* Enable auto trigger and ADC interrupt then start the first conversion */
+			ADCSRA |= (1<<ADATE) | (1<<ADIE) | (1<<ADSC) ;
+			break;
+		case ADC_TRIGGER_TIMER0_COMPARE :
+			g_adc_triggerFlag = (1<<OCF0) ;
+			break;
+		case ADC_TRIGGER_TIMER0_OVERFLOW :
+			g_adc_triggerFlag = (1<<TOV0) ;
+			break;
+		}
+
+		if(g_adc_triggerFlag != 0)
+		{
+			/* Clear the flag, a flag already set would never make the rising edge of the first trigger */
+			TIFR = g_adc_triggerFlag ;
+
+			/* Enable auto trigger and ADC interrupt, the first conversion waits for the trigger */
+			ADCSRA |= (1<<ADATE) | (1<<ADIE) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
 }
 
 /* Inputs:
- * 	1. ADC Channel Number.
+ * 	1. ADC Channel Number, any MUX4:0 input.
  *
- * Return Value: ADC register value.
+ * Return Value: ADC register value, sign extended for a differential input.
  *
  * Description:
  * 	Function responsible for read analog data from a certain ADC channel
  * 	and convert it to digital using the ADC driver.
+ * 	In free running mode it returns the latest sample of the channel without waiting.
+ * 	In polling mode the CPU sleeps until the end of the conversion if the interrupts are enabled,
+ * 	the first conversion after switching to a differential input is dropped.
  */
 uint16 ADC_readChannel(uint8 channel_num)
 {
-	if((channel_num >= 0) && (channel_num <= 7))
+	uint16 value ;
+
+	if(ADC_FREE_RUNNING_MODE == g_adc_mode)
+	{
+		value = ADC_getLatest(channel_num) ;
+	}
+	else
+	{
+		if(channel_num < ADC_NUM_OF_INPUTS)
+		{
+			value = ADC_convert(channel_num) ;
+		}
+		else
+		{
+			value = ADC ;
+		}
+	}
+
+	return value ;
+}
+
+/* Inputs:
+ * 	1. ADC Channel Number, any MUX4:0 input of the scan list.
+ *
+ * Return Value: The most recent sample of this channel, ZERO if no sample is available yet.
+ *
+ * Description:
+ * 	Function responsible for return the last conversion result stored by the ADC ISR
+ * 	for a certain channel in free running mode, it never waits for the converter.
+ */
+uint16 ADC_getLatest(uint8 channel_num)
+{
+	uint16 sample = 0 ;
+
+	if((channel_num < ADC_NUM_OF_INPUTS) && (g_adc_inputSlots[channel_num] != ADC_NO_SLOT))
 	{
-		ADMUX = ( ADMUX & 0xE0 ) | ( channel_num & 0x07 ) ;
-		ADCSRA |= (1<<ADSC) ;
-		while(!(ADCSRA & (1<<ADIF)));
-		ADCSRA |= (1<<ADIF);
+		sample = ADC_sumNewest(g_adc_samples[g_adc_inputSlots[channel_num]], &g_adc_heads[g_adc_inputSlots[channel_num]],
+							   ADC_SAMPLES_BUFFER_SIZE, 1, channel_num) ;
 	}
 
-	return ADC ;
+	return sample ;
 }
 
+/* Inputs:
+ * 	1. ADC Channel Number, any MUX4:0 input.
+ * 	2. extra_bits: resolution bits added to the 10-bit result, up to ADC_OVERSAMPLING_MAX_BITS.
+ *
+ * Return Value: The decimated result with (10 + extra_bits) bits, sign extended for a differential input.
+ *
+ * Description:
+ * 	Function responsible for read a channel with a higher resolution by oversampling and decimation.
+ * 	In free running mode it sums the newest 4^extra_bits samples of the channel history without waiting,
+ * 	so a new value is ready after each sample of the channel. It is ZERO until enough scans are complete.
+ * 	In polling mode it makes 4^extra_bits conversions, it takes 4^extra_bits times longer than ADC_readChannel.
+ */
+uint16 ADC_readOversampled(uint8 channel_num, uint8 extra_bits)
+{
+	uint16 sum = 0 ;
+	uint8 count ;
+	uint8 shift ;
 
+	extra_bits = (extra_bits > ADC_OVERSAMPLING_MAX_BITS) ? ADC_OVERSAMPLING_MAX_BITS : extra_bits ;
+	shift = extra_bits ;
+
+	if(ADC_FREE_RUNNING_MODE == g_adc_mode)
+	{
+		/* Each complete scan stored at least one sample of each of its inputs */
+		if((channel_num < ADC_NUM_OF_INPUTS) && (g_adc_inputSlots[channel_num] != ADC_NO_SLOT) &&
+		   (g_adc_scans >= ADC_OVERSAMPLING_SAMPLES(extra_bits)))
+		{
+			sum = ADC_sumNewest(g_adc_samples[g_adc_inputSlots[channel_num]], &g_adc_heads[g_adc_inputSlots[channel_num]],
+								ADC_SAMPLES_BUFFER_SIZE, ADC_OVERSAMPLING_SAMPLES(extra_bits), channel_num) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+	else
+	{
+		for(count = 0 ; count < ADC_OVERSAMPLING_SAMPLES(extra_bits) ; count++)
+		{
+			sum += ADC_readChannel(channel_num) ;
+		}
+	}
+
+	/* A differential sum is signed, its shift keeps the sign */
+	if(ADC_INPUT_IS_DIFFERENTIAL(channel_num))
+	{
+		sum = (uint16)((sint16)sum >> shift) ;
+	}
+	else
+	{
+		sum >>= shift ;
+	}
+
+	return sum ;
+}
+
+/* Inputs:
+ * 	1. Pointer to an array of scan_length values.
+ *
+ * Return Value: The generation of the snapshot, it is incremented at the end of each scan.
+ *
+ * Description:
+ * 	Function responsible for copy the results of the last complete scan in the scan list order.
+ * 	All the values are from the same scan, the copy is repeated if a scan ends during it,
+ * 	because the ISR then starts to write the copied half. The differential values are sign extended.
+ * 	The values are ZERO before the first scan is complete.
+ */
+uint8 ADC_getSnapshot(uint16 *values_ptr)
+{
+	uint8 generation ;
+	uint8 index ;
+	uint16 value ;
+
+	do
+	{
+		/* The last complete scan is in the half of the previous generation */
+		generation = g_adc_generation ;
+		for(index = 0 ; index < g_adc_scanLength ; index++)
+		{
+			value = g_adc_scanValues[(uint8)(generation - 1) & 1][index] ;
+			values_ptr[index] = ADC_INPUT_IS_DIFFERENTIAL(g_adc_scanList[index].channel) ? ADC_SIGN_EXTEND(value) : value ;
+		}
+	}while(generation != g_adc_generation);
+
+	return generation ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: The generation of the last complete scan.
+ *
+ * Description:
+ * 	Function responsible for tell the higher layers if a new snapshot is ready, without copying it.
+ */
+uint8 ADC_getGeneration(void)
+{
+	return g_adc_generation ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: ADC value of the internal bandgap, ZERO if it is not measured yet.
+ *
+ * Description:
+ * 	Function responsible for measure the bandgap with the selected reference, it is used to calibrate the reference.
+ * 	In free running mode it returns the last measurement of the scan without waiting,
+ * 	the scan measures the bandgap after its first scan then after each ADC_BANDGAP_SCAN_PERIOD scans.
+ * 	In polling mode it drops the first conversion after the mux switch, so the bandgap has time to settle.
+ */
+uint16 ADC_readBandgap(void)
+{
+	uint16 value = 0 ;
+
+	if(ADC_FREE_RUNNING_MODE == g_adc_mode)
+	{
+		/* The head can not tell if a measurement was done, it wraps */
+		if(TRUE == g_adc_bandgapReady)
+		{
+			value = ADC_sumNewest(g_adc_bandgapValues, &g_adc_bandgapHead, ADC_BANDGAP_BUFFER_SIZE, 1, ADC_BANDGAP_CHANNEL) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+	else
+	{
+		value = ADC_convert(ADC_BANDGAP_CHANNEL) ;
+	}
+
+	return value ;
+}
+
+/****************************************************************************
+ * 						   Private Functions Definitions				    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. step: the scan list index with ADC_SCAN_DISCARD_STEP and ADC_SCAN_BANDGAP_STEP flags.
+ *
+ * Return Value: The next scan step.
+ *
+ * Description:
+ * 	Function responsible for find the next conversion of the scan in a round robin order.
+ * 	An entry with discard_first gets a settling conversion first, only if the mux is switched to another channel.
+ * 	The bandgap measurement is inserted at the end of the scan after each ADC_BANDGAP_SCAN_PERIOD scans.
+ */
+static uint8 ADC_nextStep(uint8 step)
+{
+	uint8 next ;
+
+	if(step & ADC_SCAN_DISCARD_STEP)
+	{
+		/* The settling conversion is followed by the real one of the same step */
+		next = step & ~ADC_SCAN_DISCARD_STEP ;
+	}
+	else
+	{
+		if(step & ADC_SCAN_BANDGAP_STEP)
+		{
+			/* The scan starts again after the bandgap measurement */
+			next = 0 ;
+		}
+		else
+		{
+			next = (((step & ADC_SCAN_INDEX_MASK) + 1) < g_adc_scanLength) ? ((step & ADC_SCAN_INDEX_MASK) + 1) : 0 ;
+			g_adc_bandgapScans += (0 == next) ? 1 : 0 ;
+		}
+
+		if(g_adc_bandgapScans >= ADC_BANDGAP_SCAN_PERIOD)
+		{
+			/* The bandgap always needs a settling conversion after the mux switch */
+			g_adc_bandgapScans = 0 ;
+			next = ADC_SCAN_BANDGAP_STEP | ADC_SCAN_DISCARD_STEP ;
+		}
+		else if((TRUE == g_adc_scanList[next].discard_first) && (g_adc_scanList[next].channel != ADC_stepMux(step)))
+		{
+			next |= ADC_SCAN_DISCARD_STEP ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+
+	return next ;
+}
+
+/* Inputs:
+ * 	1. step: the scan step with its flags.
+ *
+ * Return Value: ADMUX MUX4:0 value of the step.
+ *
+ * Description:
+ * 	Function responsible for find the ADC input of a scan step.
+ */
+static uint8 ADC_stepMux(uint8 step)
+{
+	return (step & ADC_SCAN_BANDGAP_STEP) ? ADC_BANDGAP_CHANNEL : g_adc_scanList[step & ADC_SCAN_INDEX_MASK].channel ;
+}
+
+/* Inputs:
+ * 	1. mux: ADMUX MUX4:0 value of the input.
+ *
+ * Return Value: ADC register value.
+ *
+ * Description:
+ * 	Function responsible for do one polling mode conversion of the input.
+ * 	The CPU sleeps until the end of the conversion if the interrupts are enabled.
+ * 	A differential input or the bandgap gets one more conversion first if ADMUX is switched to it.
+ */
+static uint16 ADC_convert(uint8 mux)
+{
+	Power_SleepMode mode ;
+	uint8 conversions = 1 ;
+	uint16 value ;
+
+	mux &= (ADC_NUM_OF_INPUTS - 1) ;
+	if((ADC_INPUT_IS_DIFFERENTIAL(mux) || (ADC_BANDGAP_CHANNEL == mux)) && (( ADMUX & 0x1F ) != mux))
+	{
+		/* The gain stage or the bandgap settles during a first conversion which is dropped */
+		conversions = 2 ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	ADMUX = ( ADMUX & 0xE0 ) | mux ;
+
+	for( ; conversions > 0 ; conversions--)
+	{
+		if(SREG & (1<<SREG_I))
+		{
+			/* Sleep during the conversion, the CPU is quiet and the ADC interrupt wakes it up */
+			mode = Power_getAdcSleepMode() ;
+			g_adc_conversionDone = FALSE ;
+			cli();
+			ADCSRA |= (1<<ADIE) | (1<<ADSC) ;
+			while(FALSE == g_adc_conversionDone)
+			{
+				/* Another interrupt may wake up the CPU before the end of the conversion */
+				Power_sleep(mode);
+				cli();
+			}
+			ADCSRA &= ~(1<<ADIE) ;
+			sei();
+		}
+		else
+		{
+			/* No interrupt can wake up the CPU, wait for the flag */
+			ADCSRA |= (1<<ADSC) ;
+			while(!(ADCSRA & (1<<ADIF)));
+			ADCSRA |= (1<<ADIF);
+		}
+	}
+
+	value = ADC ;
+
+	return ADC_INPUT_IS_DIFFERENTIAL(mux) ? ADC_SIGN_EXTEND(value) : value ;
+}
+
+/* Inputs:
+ * 	1. samples_ptr: the sample history written by the ADC ISR.
+ * 	2. head_ptr   : its head, the index of the next sample.
+ * 	3. size       : the history size, a power of two.
+ * 	4. count      : number of newest samples, less than size.
+ * 	5. mux        : MUX4:0 input of the samples, a differential one is sign extended.
+ *
+ * Return Value: The sum of the newest samples.
+ *
+ * Description:
+ * 	Function responsible for sum the newest samples of a history without disabling the interrupts.
+ * 	The ISR writes the sample at the head before it increments it, so the samples behind the head are complete.
+ * 	If the ISR stored more than (size - count) samples during the sum it overwrote the oldest one, the sum is made again.
+ */
+static uint16 ADC_sumNewest(const volatile uint16 *samples_ptr, const volatile uint8 *head_ptr, uint8 size, uint8 count, uint8 mux)
+{
+	uint16 sum ;
+	uint16 sample ;
+	uint8 head ;
+	uint8 index ;
+
+	do
+	{
+		head = *head_ptr ;
+		sum = 0 ;
+		for(index = 1 ; index <= count ; index++)
+		{
+			sample = samples_ptr[(uint8)(head - index) & (size - 1)] ;
+			sum += ADC_INPUT_IS_DIFFERENTIAL(mux) ? ADC_SIGN_EXTEND(sample) : sample ;
+		}
+	}while((uint8)(*head_ptr - head) > (uint8)(size - count));
+
+	return sum ;
+}
@@ -20,8 +20,33 @@
 /****************************************************************************
  * 								 Definitions								*
  ****************************************************************************/
+#ifndef F_CPU
+#define F_CPU 				 1000000UL
+#endif
+
 #define ADC_MAXIMUM_VALUE    1023
-#define ADC_REF_VOLT_VALUE   2.56
+#define ADC_REF_VOLT_MV      2560
+
+/* ADC clock range, the full 10-bit resolution needs 50 to 200 kHz, a lower resolution accepts up to 1 MHz */
+#define ADC_RESOLUTION_BITS	 10
+#define ADC_CLOCK_MIN_HZ	 50000UL
+#define ADC_CLOCK_MAX_HZ	 ((ADC_RESOLUTION_BITS < 10) ? 1000000UL : 200000UL)
+
+/* ADC clock of a prescaler, the ADC_Prescaler value n divides F_CPU by 2^n */
+#define ADC_CLOCK_HZ(prescaler)			(F_CPU >> (prescaler))
+#define ADC_CLOCK_IS_VALID(prescaler)	((ADC_CLOCK_HZ(prescaler) >= ADC_CLOCK_MIN_HZ) && (ADC_CLOCK_HZ(prescaler) <= ADC_CLOCK_MAX_HZ))
+
+/* The fastest ADC clock which is not above ADC_CLOCK_MAX_HZ, found at compile time from F_CPU */
+#define ADC_PRESCALER_AUTO	\
+	((ADC_CLOCK_HZ(1) <= ADC_CLOCK_MAX_HZ) ? F_CPU_2  : \
+	 (ADC_CLOCK_HZ(2) <= ADC_CLOCK_MAX_HZ) ? F_CPU_4  : \
+	 (ADC_CLOCK_HZ(3) <= ADC_CLOCK_MAX_HZ) ? F_CPU_8  : \
+	 (ADC_CLOCK_HZ(4) <= ADC_CLOCK_MAX_HZ) ? F_CPU_16 : \
+	 (ADC_CLOCK_HZ(5) <= ADC_CLOCK_MAX_HZ) ? F_CPU_32 : \
+	 (ADC_CLOCK_HZ(6) <= ADC_CLOCK_MAX_HZ) ? F_CPU_64 : F_CPU_128)
+
+/* A prescaler chosen by hand, the compilation stops if its ADC clock is out of the range */
+#define ADC_PRESCALER_MANUAL(prescaler)	((ADC_Prescaler)((prescaler) + STATIC_CHECK_ZERO(ADC_CLOCK_IS_VALID(prescaler))))
 
 #define ADC0 			     0
 #define ADC1 			     1
@@ -32,6 +57,49 @@
 #define ADC6 			     6
 #define ADC7 			     7
 
+#define ADC_NUM_OF_CHANNELS			 8
+
+/* All the inputs selected by MUX4:0: single ended, differential, bandgap and GND */
+#define ADC_NUM_OF_INPUTS			 32
+#define ADC_GND_CHANNEL				 0x1F
+
+/* Differential inputs decoding, a single ended input is its own positive pin with 1x gain.
+ * The differential results are signed 10-bit values from -512 to 511, the driver extends their sign to 16 bits,
+ * so they are read as sint16: value = (positive - negative) * gain * 512 / reference. */
+#define ADC_INPUT_IS_DIFFERENTIAL(input)	(((input) >= ADC_DIFF_ADC0_ADC0_X10) && ((input) <= ADC_DIFF_ADC5_ADC2_X1))
+#define ADC_INPUT_GAIN(input)				((((input) < ADC_DIFF_ADC0_ADC0_X10) || ((input) >= ADC_DIFF_ADC0_ADC1_X1)) ? 1 : \
+											 (((input) & 0x02) ? 200 : 10))
+#define ADC_INPUT_POSITIVE_PIN(input)		(((input) < ADC_DIFF_ADC0_ADC0_X10) ? (input) : \
+											 (((input) < ADC_DIFF_ADC0_ADC1_X1) ? ((((input) & 0x04) >> 1) | ((input) & 0x01)) : ((input) & 0x07)))
+#define ADC_INPUT_NEGATIVE_PIN(input)		(((input) < ADC_DIFF_ADC0_ADC1_X1) ? (((input) & 0x04) >> 1) : \
+											 (((input) < ADC_DIFF_ADC0_ADC2_X1) ? ADC1 : ADC2))
+
+/* Sign extension of a differential 10-bit result */
+#define ADC_SIGN_EXTEND(value)				(((value) & 0x0200) ? ((value) | 0xFC00) : (value))
+
+/* Internal 1.22V bandgap input in MUX4:0 and its value with an exact ADC_REF_VOLT_MV reference (488) */
+#define ADC_BANDGAP_CHANNEL			 0x1E
+#define ADC_BANDGAP_MV				 1220
+#define ADC_BANDGAP_NOMINAL_VALUE	 ((uint16)(((uint32)ADC_BANDGAP_MV * (ADC_MAXIMUM_VALUE + 1)) / ADC_REF_VOLT_MV))
+
+/* Free running mode: the bandgap is measured after each ADC_BANDGAP_SCAN_PERIOD scans (max 255) */
+#define ADC_BANDGAP_SCAN_PERIOD		 200
+
+/* Number of samples kept per channel in free running mode, it must be a power of two (max 128)
+ * with at least twice the oversampling samples */
+#define ADC_SAMPLES_BUFFER_SIZE		 32
+
+/* Maximum length of the free running scan list, a channel may be listed more than once */
+#define ADC_SCAN_MAX_ENTRIES		 8
+
+/* Oversampling: 4^n conversions are summed then shifted right by n to get n extra bits.
+ * It works only if the input has about 1 LSB of noise, a perfectly stable input gains nothing.
+ * In free running mode the reader sums the newest 4^n samples of the channel history, so the value is a moving average
+ * which changes after each sample of the channel, with two channels and the Timer0 overflow trigger
+ * 2 extra bits average the last 65 ms. */
+#define ADC_OVERSAMPLING_MAX_BITS	 2
+#define ADC_OVERSAMPLING_SAMPLES(extra_bits)	(1U << (2 * (extra_bits)))
+
 /****************************************************************************
  * 					          Types Declaration						        *
  ****************************************************************************/
@@ -55,10 +123,75 @@ typedef enum
 
 }ADC_Prescaler;
 
+typedef enum
+{
+	ADC_POLLING_MODE,
+	ADC_FREE_RUNNING_MODE
+
+}ADC_OperationMode;
+
+/* Start of the free running mode conversions, the values are the ADTS2:0 bits.
+ * Back to back conversions take 13 ADC clocks, 104 us with F_CPU_8 at 1MHz, so the ADC ISR comes every 104 CPU cycles,
+ * which is less than the ISR itself and the CPU never sleeps, it is only for a faster F_CPU or a slower ADC clock.
+ * With a Timer0 source every conversion starts at a fixed phase of the zone 0 PWM period,
+ * the sample and hold is done 2 ADC clocks after the trigger (16 us with F_CPU_8 at 1MHz).
+ * The rate is the Timer0 overflow rate F_CPU / (PWM prescaler * 256), 488 conversions per second with the
+ * PWM_F_CPU_8 prescaler at 1MHz, so each channel of a two channels scan gets 244 samples per second.
+ * The overflow is the start of the PWM period whatever the duty is, the compare match moves with the duty. */
+typedef enum
+{
+	ADC_TRIGGER_FREE_RUNNING,
+	ADC_TRIGGER_TIMER0_COMPARE = 0x03,
+	ADC_TRIGGER_TIMER0_OVERFLOW
+
+}ADC_TriggerSource;
+
+/* Differential inputs in MUX4:0, ADC_DIFF_positive_negative_gain.
+ * The gain stage needs one conversion to settle after the mux switch, so scan them with discard_first.
+ * The same pin pairs (ADC0_ADC0, ADC2_ADC2) measure the offset of the gain stage. */
+typedef enum
+{
+	ADC_DIFF_ADC0_ADC0_X10 = 0x08,
+	ADC_DIFF_ADC1_ADC0_X10,
+	ADC_DIFF_ADC0_ADC0_X200,
+	ADC_DIFF_ADC1_ADC0_X200,
+	ADC_DIFF_ADC2_ADC2_X10,
+	ADC_DIFF_ADC3_ADC2_X10,
+	ADC_DIFF_ADC2_ADC2_X200,
+	ADC_DIFF_ADC3_ADC2_X200,
+	ADC_DIFF_ADC0_ADC1_X1,
+	ADC_DIFF_ADC1_ADC1_X1,
+	ADC_DIFF_ADC2_ADC1_X1,
+	ADC_DIFF_ADC3_ADC1_X1,
+	ADC_DIFF_ADC4_ADC1_X1,
+	ADC_DIFF_ADC5_ADC1_X1,
+	ADC_DIFF_ADC6_ADC1_X1,
+	ADC_DIFF_ADC7_ADC1_X1,
+	ADC_DIFF_ADC0_ADC2_X1,
+	ADC_DIFF_ADC1_ADC2_X1,
+	ADC_DIFF_ADC2_ADC2_X1,
+	ADC_DIFF_ADC3_ADC2_X1,
+	ADC_DIFF_ADC4_ADC2_X1,
+	ADC_DIFF_ADC5_ADC2_X1
+
+}ADC_DifferentialInput;
+
+typedef struct
+{
+	uint8 channel;			/* MUX4:0 input: ADC0..ADC7, ADC_DifferentialInput or ADC_BANDGAP_CHANNEL */
+	boolean discard_first;	/* A high impedance source or a gain stage needs one more conversion to settle after the mux switch */
+
+}ADC_ScanEntryType;
+
 typedef struct
 {
 	ADC_ReferenceVolatge ref_volt;
 	ADC_Prescaler prescaler;
+	ADC_OperationMode mode;
+	uint8 channels_mask;	/* Channels sampled in free running mode, bit n for ADCn */
+	const ADC_ScanEntryType *scan_list;	/* Free running mode scan order, NULL_PTR to scan channels_mask in order */
+	uint8 scan_length;
+	ADC_TriggerSource trigger_source;	/* Free running mode: back to back conversions or one conversion per trigger */
 
 }ADC_ConfigType;
 
@@ -73,19 +206,85 @@ typedef struct
  *
  * Description:
  * 	Function responsible for initialize the ADC driver.
+ * 	In free running mode the ADC ISR steps through the scan list, it switches ADMUX while the next
+ * 	conversion runs, so the channels are sampled back to back without waiting.
+ * 	With a trigger source a conversion starts at each trigger event, so each sample is taken at the same
+ * 	phase of the PWM period without the CPU, Timer0 must be started by the PWM driver.
  */
 void ADC_init(const ADC_ConfigType * Config_Ptr);
 
 /* Inputs:
- * 	1. ADC Channel Number.
+ * 	1. ADC Channel Number, any MUX4:0 input.
  *
- * Return Value: ADC register value.
+ * Return Value: ADC register value, sign extended for a differential input.
  *
  * Description:
  * 	Function responsible for read analog data from a certain ADC channel
  * 	and convert it to digital using the ADC driver.
+ * 	In free running mode it returns the latest sample of the channel without waiting.
+ * 	In polling mode the CPU sleeps until the end of the conversion if the interrupts are enabled,
+ * 	the first conversion after switching to a differential input is dropped.
  */
 uint16 ADC_readChannel(uint8 channel_num);
 
+/* Inputs:
+ * 	1. ADC Channel Number, any MUX4:0 input of the scan list.
+ *
+ * Return Value: The most recent sample of this channel, ZERO if no sample is available yet.
+ *
+ * Description:
+ * 	Function responsible for return the last conversion result stored by the ADC ISR
+ * 	for a certain channel in free running mode, it never waits for the converter.
+ */
+uint16 ADC_getLatest(uint8 channel_num);
+
+/* Inputs:
+ * 	1. ADC Channel Number, any MUX4:0 input.
+ * 	2. extra_bits: resolution bits added to the 10-bit result, up to ADC_OVERSAMPLING_MAX_BITS.
+ *
+ * Return Value: The decimated result with (10 + extra_bits) bits, sign extended for a differential input.
+ *
+ * Description:
+ * 	Function responsible for read a channel with a higher resolution by oversampling and decimation.
+ * 	In free running mode it sums the newest 4^extra_bits samples of the channel history without waiting,
+ * 	so a new value is ready after each sample of the channel. It is ZERO until enough scans are complete.
+ * 	In polling mode it makes 4^extra_bits conversions, it takes 4^extra_bits times longer than ADC_readChannel.
+ */
+uint16 ADC_readOversampled(uint8 channel_num, uint8 extra_bits);
+
+/* Inputs:
+ * 	1. Pointer to an array of scan_length values.
+ *
+ * Return Value: The generation of the snapshot, it is incremented at the end of each scan.
+ *
+ * Description:
+ * 	Function responsible for copy the results of the last complete scan in the scan list order.
+ * 	All the values are from the same scan, the copy is repeated if a scan ends during it,
+ * 	because the ISR then starts to write the copied half. The differential values are sign extended.
+ * 	The values are ZERO before the first scan is complete.
+ */
+uint8 ADC_getSnapshot(uint16 *values_ptr);
+
+/* Inputs: void.
+ *
+ * Return Value: The generation of the last complete scan.
+ *
+ * Description:
+ * 	Function responsible for tell the higher layers if a new snapshot is ready, without copying it.
+ */
+uint8 ADC_getGeneration(void);
+
+/* Inputs: void.
+ *
+ * Return Value: ADC value of the internal bandgap, ZERO if it is not measured yet.
+ *
+ * Description:
+ * 	Function responsible for measure the bandgap with the selected reference, it is used to calibrate the reference.
+ * 	In free running mode it returns the last measurement of the scan without waiting,
+ * 	the scan measures the bandgap after its first scan then after each ADC_BANDGAP_SCAN_PERIOD scans.
+ * 	In polling mode it drops the first conversion after the mux switch, so the bandgap has time to settle.
+ */
+uint16 ADC_readBandgap(void);
+
 
 #endif /* ADC_H_ */
@@ -0,0 +1,134 @@
+/*
+ ============================================================================
+ Name        : eeprom.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Interrupt Driven EEPROM Write Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/interrupt.h>
+#include "eeprom.h"
+#include "ring_buffer.h"
+
+#if !RING_BUFFER_SIZE_IS_VALID(EEPROM_WRITE_QUEUE_SIZE)
+#error "EEPROM_WRITE_QUEUE_SIZE must be a power of two and not more than 128"
+#endif
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef struct
+{
+	uint16 address ;
+	uint8 data ;
+}EEPROM_WriteType;
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+
+/* The main loop produces the bytes and the EEPROM ready ISR consumes them */
+static volatile EEPROM_WriteType g_eeprom_writes[EEPROM_WRITE_QUEUE_SIZE] ;
+static RingBuffer_Type g_eeprom_ring ;
+
+/****************************************************************************
+ * 						   Interrupt Service Routines					    *
+ ****************************************************************************/
+ISR(EE_RDY_vect)
+{
+	EEPROM_WriteType write ;
+
+	if(RingBuffer_pop(&g_eeprom_ring, &write))
+	{
+		EEAR = write.address ;
+
+		/* An unchanged byte is not written to save the EEPROM cycles, the interrupt comes again directly */
+		EECR |= (1<<EERE) ;
+		if(EEDR != write.data)
+		{
+			EEDR = write.data ;
+
+			/* EEWE must be set within 4 cycles after EEMWE, nothing can interrupt the ISR in between */
+			EECR |= (1<<EEMWE) ;
+			EECR |= (1<<EEWE) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+	else
+	{
+		/* Nothing to write, the interrupt is enabled again by EEPROM_write */
+		EECR &= ~(1<<EERIE) ;
+	}
+}
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for make the write queue empty, it should be called before EEPROM_write.
+ */
+void EEPROM_init(void)
+{
+	EECR &= ~(1<<EERIE) ;
+	RingBuffer_init(&g_eeprom_ring, g_eeprom_writes, sizeof(EEPROM_WriteType), EEPROM_WRITE_QUEUE_SIZE);
+}
+
+/* Inputs:
+ * 	1. address : EEPROM address of the first byte.
+ * 	2. data_ptr: pointer to the bytes to be written.
+ * 	3. length  : number of bytes.
+ *
+ * Return Value: TRUE if all the bytes were queued, FALSE if there is no space for all of them or they are out of the EEPROM.
+ *
+ * Description:
+ * 	Function responsible for queue the bytes, it never waits for the 8.5 ms write of a byte.
+ * 	The EEPROM ready interrupt writes them one by one in the background, an unchanged byte is not written.
+ * 	The avr-libc eeprom functions should not be used while EEPROM_isBusy returns TRUE,
+ * 	the interrupt changes the EEPROM address register.
+ */
+boolean EEPROM_write(uint16 address, const uint8 *data_ptr, uint8 length)
+{
+	boolean status = FALSE ;
+	EEPROM_WriteType write ;
+	uint8 index ;
+
+	/* The ISR can only free more space, so all the bytes fit after the check */
+	if((data_ptr != NULL_PTR) && (length <= RingBuffer_getFree(&g_eeprom_ring)) &&
+	   (address < EEPROM_SIZE) && (length <= (EEPROM_SIZE - address)))
+	{
+		for(index = 0 ; index < length ; index++)
+		{
+			write.address = address + index ;
+			write.data = data_ptr[index] ;
+			RingBuffer_push(&g_eeprom_ring, &write);
+		}
+		EECR |= (1<<EERIE) ;
+		status = TRUE ;
+	}
+
+	return status ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE while a queued byte is not written yet.
+ *
+ * Description:
+ * 	Function responsible for tell if the EEPROM writes are still running.
+ */
+boolean EEPROM_isBusy(void)
+{
+	return ((0 != RingBuffer_getCount(&g_eeprom_ring)) || (EECR & (1<<EEWE))) ? TRUE : FALSE ;
+}
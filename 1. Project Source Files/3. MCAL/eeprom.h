@@ -0,0 +1,67 @@
+/*
+ ============================================================================
+ Name        : eeprom.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Interrupt Driven EEPROM Write Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+#include "std_types.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* Number of bytes waiting to be written, it must be a power of two (max 128) */
+#define EEPROM_WRITE_QUEUE_SIZE		8
+
+/* ATmega32 EEPROM size in bytes */
+#define EEPROM_SIZE					1024
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for make the write queue empty, it should be called before EEPROM_write.
+ */
+void EEPROM_init(void);
+
+/* Inputs:
+ * 	1. address : EEPROM address of the first byte.
+ * 	2. data_ptr: pointer to the bytes to be written.
+ * 	3. length  : number of bytes.
+ *
+ * Return Value: TRUE if all the bytes were queued, FALSE if there is no space for all of them or they are out of the EEPROM.
+ *
+ * Description:
+ * 	Function responsible for queue the bytes, it never waits for the 8.5 ms write of a byte.
+ * 	The EEPROM ready interrupt writes them one by one in the background, an unchanged byte is not written.
+ * 	The avr-libc eeprom functions should not be used while EEPROM_isBusy returns TRUE,
+ * 	the interrupt changes the EEPROM address register.
+ */
+boolean EEPROM_write(uint16 address, const uint8 *data_ptr, uint8 length);
+
+/* Inputs: void.
+ *
+ * Return Value: TRUE while a queued byte is not written yet.
+ *
+ * Description:
+ * 	Function responsible for tell if the EEPROM writes are still running.
+ */
+boolean EEPROM_isBusy(void);
+
+
+#endif /* EEPROM_H_ */
@@ -10,6 +10,7 @@
 /****************************************************************************
  * 								  Includes								    *
  ****************************************************************************/
+#include <avr/interrupt.h>
 #include "gpio.h"
 
 /****************************************************************************
@@ -386,4 +387,82 @@ uint8 GPIO_readPort(uint8 port_num)
 	return value ;
 }
 
+/* Inputs:
+ * 	1. port_num  : ID for the port number.
+ * 	2. mask      : the pins to be written, bit n for pin n.
+ * 	3. value     : the values of the masked pins, the other bits are ignored.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Write the masked pins of the required port with one read-modify-write,
+ * 	the interrupts are disabled during the write so all the pins change together.
+ * 	If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePortMasked(uint8 port_num,
+		uint8 mask,
+		uint8 value)
+{
+	uint8 sreg ;
+
+	if((port_num >= PORTA_ID) && (port_num <= PORTD_ID))
+	{
+		value &= mask ;
+
+		/* An interrupt between the read and the write could change the other pins */
+		sreg = SREG ;
+		cli();
+
+		switch(port_num)
+		{
+		case PORTA_ID :
+			PORTA = ( PORTA & (~mask) ) | value ;
+			break;
+		case PORTB_ID :
+			PORTB = ( PORTB & (~mask) ) | value ;
+			break;
+		case PORTC_ID :
+			PORTC = ( PORTC & (~mask) ) | value ;
+			break;
+		case PORTD_ID :
+			PORTD = ( PORTD & (~mask) ) | value ;
+			break;
+		}
 
+		SREG = sreg ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+/* Inputs:
+ * 	1. port_num  : ID for the port number.
+ * 	2. first_pin : ID for the lowest pin of the group.
+ * 	3. width     : number of adjacent pins in the group.
+ * 	4. value     : value to be written on the group, bit 0 goes to the first pin.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Write a group of adjacent pins like a data bus nibble with one atomic write.
+ * 	If the input port number or the pins group are not correct, The function will not handle the request.
+ */
+void GPIO_writePinsShifted(uint8 port_num,
+		uint8 first_pin,
+		uint8 width,
+		uint8 value)
+{
+	uint8 mask ;
+
+	if((width >= 1) && ((first_pin + width) <= NUM_OF_PINS_PER_PORT))
+	{
+		mask = (uint8)(((1<<width) - 1) << first_pin) ;
+		GPIO_writePortMasked(port_num, mask, (uint8)(value << first_pin));
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
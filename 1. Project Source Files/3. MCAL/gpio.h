@@ -37,6 +37,54 @@
 #define PIN6_ID 				6
 #define PIN7_ID 				7
 
+/*
+ * Static GPIO access for pins known at compile time:
+ * The port ID selects the register at compile time, so with constant port and pin IDs
+ * a pin write becomes a single SBI/CBI instruction and a pin read becomes SBIS/SBIC or IN.
+ * A wrong or non constant port/pin ID stops the compilation.
+ * Use the GPIO functions for the pins which are known only at run time.
+ */
+#define GPIO_PORT_REG(port_num)		(*(((port_num) == PORTA_ID) ? &PORTA : \
+									   ((port_num) == PORTB_ID) ? &PORTB : \
+									   ((port_num) == PORTC_ID) ? &PORTC : &PORTD))
+
+#define GPIO_DDR_REG(port_num)		(*(((port_num) == PORTA_ID) ? &DDRA : \
+									   ((port_num) == PORTB_ID) ? &DDRB : \
+									   ((port_num) == PORTC_ID) ? &DDRC : &DDRD))
+
+#define GPIO_PIN_REG(port_num)		(*(((port_num) == PORTA_ID) ? &PINA : \
+									   ((port_num) == PORTB_ID) ? &PINB : \
+									   ((port_num) == PORTC_ID) ? &PINC : &PIND))
+
+/* Return the port ID or the pin ID after checking them at compile time */
+#define GPIO_STATIC_PORT(port_num)			((port_num) + STATIC_CHECK_ZERO(((port_num) >= PORTA_ID) && ((port_num) <= PORTD_ID)))
+#define GPIO_STATIC_PIN(port_num,pin_num)	((pin_num) + STATIC_CHECK_ZERO(((port_num) >= PORTA_ID) && ((port_num) <= PORTD_ID) && \
+																	   ((pin_num) >= PIN0_ID) && ((pin_num) <= PIN7_ID)))
+
+#define GPIO_STATIC_SETUP_PIN_DIRECTION(port_num,pin_num,direction) \
+	do { \
+		if(PIN_OUTPUT == (direction)) { SET_BIT(GPIO_DDR_REG(port_num), GPIO_STATIC_PIN(port_num,pin_num)); } \
+		else { CLEAR_BIT(GPIO_DDR_REG(port_num), GPIO_STATIC_PIN(port_num,pin_num)); } \
+	} while(0)
+
+#define GPIO_STATIC_WRITE_PIN(port_num,pin_num,value) \
+	do { \
+		if(LOGIC_LOW != (value)) { SET_BIT(GPIO_PORT_REG(port_num), GPIO_STATIC_PIN(port_num,pin_num)); } \
+		else { CLEAR_BIT(GPIO_PORT_REG(port_num), GPIO_STATIC_PIN(port_num,pin_num)); } \
+	} while(0)
+
+#define GPIO_STATIC_READ_PIN(port_num,pin_num) \
+	((uint8)GET_BIT(GPIO_PIN_REG(port_num), GPIO_STATIC_PIN(port_num,pin_num)))
+
+#define GPIO_STATIC_SETUP_PORT_DIRECTION(port_num,direction) \
+	(GPIO_DDR_REG(GPIO_STATIC_PORT(port_num)) = (uint8)(direction))
+
+#define GPIO_STATIC_WRITE_PORT(port_num,value) \
+	(GPIO_PORT_REG(GPIO_STATIC_PORT(port_num)) = (uint8)(value))
+
+#define GPIO_STATIC_READ_PORT(port_num) \
+	(GPIO_PIN_REG(GPIO_STATIC_PORT(port_num)))
+
 /****************************************************************************
  * 					          Types Declaration						        *
  ****************************************************************************/
@@ -144,4 +192,37 @@ void GPIO_writePort(uint8 port_num,
  */
 uint8 GPIO_readPort(uint8 port_num);
 
+/* Inputs:
+ * 	1. port_num  : ID for the port number.
+ * 	2. mask      : the pins to be written, bit n for pin n.
+ * 	3. value     : the values of the masked pins, the other bits are ignored.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Write the masked pins of the required port with one read-modify-write,
+ * 	the interrupts are disabled during the write so all the pins change together.
+ * 	If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePortMasked(uint8 port_num,
+						  uint8 mask,
+						  uint8 value);
+
+/* Inputs:
+ * 	1. port_num  : ID for the port number.
+ * 	2. first_pin : ID for the lowest pin of the group.
+ * 	3. width     : number of adjacent pins in the group.
+ * 	4. value     : value to be written on the group, bit 0 goes to the first pin.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Write a group of adjacent pins like a data bus nibble with one atomic write.
+ * 	If the input port number or the pins group are not correct, The function will not handle the request.
+ */
+void GPIO_writePinsShifted(uint8 port_num,
+						   uint8 first_pin,
+						   uint8 width,
+						   uint8 value);
+
 #endif /* GPIO_H_ */
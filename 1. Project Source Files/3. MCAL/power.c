@@ -0,0 +1,73 @@
+/*
+ ============================================================================
+ Name        : power.c
+ Author      : Ahmed Shawky
+ Description : Source File for Power Management Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "power.h"
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. mode: the required sleep mode.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for put the CPU to sleep until an interrupt wakes it up.
+ * 	It should be called with the interrupts disabled after checking the wake up condition,
+ * 	sei then sleep are executed without an interrupt in between so the wake up can not be missed.
+ * 	It returns after the ISR with the interrupts enabled.
+ */
+void Power_sleep(Power_SleepMode mode)
+{
+	switch(mode)
+	{
+	case POWER_IDLE :
+		set_sleep_mode(SLEEP_MODE_IDLE);
+		break;
+	case POWER_ADC_NOISE_REDUCTION :
+		set_sleep_mode(SLEEP_MODE_ADC);
+		break;
+	}
+
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+}
+
+/* Inputs: void.
+ *
+ * Return Value: The sleep mode to be used during an ADC conversion.
+ *
+ * Description:
+ * 	Function responsible for choose ADC Noise Reduction mode only if no timer clocked by the I/O clock is running.
+ * 	ADC Noise Reduction mode stops Timer0 and Timer1, so the fan PWM and the scheduler tick
+ * 	would stop during the conversion, in this case the CPU sleeps in Idle mode.
+ */
+Power_SleepMode Power_getAdcSleepMode(void)
+{
+	Power_SleepMode mode = POWER_ADC_NOISE_REDUCTION ;
+
+	if((TCCR0 & 0x07) || (TCCR1B & 0x07) || ((TCCR2 & 0x07) && !(ASSR & (1<<AS2))))
+	{
+		mode = POWER_IDLE ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return mode ;
+}
@@ -0,0 +1,58 @@
+/*
+ ============================================================================
+ Name        : power.h
+ Author      : Ahmed Shawky
+ Description : Header File for Power Management Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef POWER_H_
+#define POWER_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+#include "std_types.h"
+
+/****************************************************************************
+ * 					          Types Declaration						        *
+ ****************************************************************************/
+typedef enum
+{
+	POWER_IDLE,						/* CPU and flash clocks stopped, all the peripherals keep running */
+	POWER_ADC_NOISE_REDUCTION		/* I/O clock stopped too, only the ADC, TWI, Timer2 async and external interrupts run */
+
+}Power_SleepMode;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. mode: the required sleep mode.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for put the CPU to sleep until an interrupt wakes it up.
+ * 	It should be called with the interrupts disabled after checking the wake up condition,
+ * 	sei then sleep are executed without an interrupt in between so the wake up can not be missed.
+ * 	It returns after the ISR with the interrupts enabled.
+ */
+void Power_sleep(Power_SleepMode mode);
+
+/* Inputs: void.
+ *
+ * Return Value: The sleep mode to be used during an ADC conversion.
+ *
+ * Description:
+ * 	Function responsible for choose ADC Noise Reduction mode only if no timer clocked by the I/O clock is running.
+ * 	ADC Noise Reduction mode stops Timer0 and Timer1, so the fan PWM and the scheduler tick
+ * 	would stop during the conversion, in this case the CPU sleeps in Idle mode.
+ */
+Power_SleepMode Power_getAdcSleepMode(void);
+
+
+#endif /* POWER_H_ */
@@ -17,25 +17,43 @@
  ****************************************************************************/
 
 /* Inputs:
- * 	1. duty_cycle: The required duty cycle percentage of the generated PWM signal.
+ * 	1. Pointer to the configuration structure with type PWM_Timer0_ConfigType.
  *
  * Return Value: void.
  *
  * Description:
- * 	The function responsible for trigger the Timer0 with the PWM Mode.
- * 	Setup the PWM mode with Non-Inverting.
- * 	Setup the prescaler with F_CPU/8.
- * 	Setup the compare value based on the required input duty cycle.
+ * 	The function responsible for start the Timer0 with the Fast PWM Mode, it should be called once.
+ * 	Setup the PWM output mode and the prescaler from the configuration.
+ * 	Setup the initial compare value.
  *	Setup the direction for OC0 as output pin through the GPIO driver.
- *	The generated PWM signal frequency will be 500Hz to control the DC Motor speed.
+ *	With F_CPU = 1MHz and F_CPU/8 prescaler the PWM signal frequency is about 500Hz.
  */
-void PWM_Timer0_Start(float duty_cycle)
+void PWM_Timer0_Init(const PWM_Timer0_ConfigType * Config_Ptr)
 {
-	GPIO_setupPinDirection(PORTB_ID, PIN3_ID, PIN_OUTPUT);
-
-	TCCR0 |= (1<<WGM00) | (1<<WGM01) | (1<<COM01) | (1<<CS01) ;
+	GPIO_STATIC_SETUP_PIN_DIRECTION(PWM_OC0_PORT_ID, PWM_OC0_PIN_ID, PIN_OUTPUT);
 
 	TCNT0 = 0 ;
 
-	OCR0 = ( duty_cycle * 255 ) ;
+	OCR0 = Config_Ptr->duty ;
+
+	/* Fast PWM mode, the output mode in COM01:0 and the prescaler in CS02:0 */
+	TCCR0 = (1<<WGM00) | (1<<WGM01) | ( Config_Ptr->output_mode << COM00 ) | ( Config_Ptr->prescaler ) ;
+}
+
+/* Inputs:
+ * 	1. duty: The required compare value from 0 to PWM_MAXIMUM_DUTY.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	The function responsible for change the duty cycle of the running PWM signal.
+ * 	OCR0 is written only if the value changes, the hardware double buffers it
+ * 	until the end of the current period, so the update never cuts a period.
+ */
+void PWM_Timer0_SetDuty(uint8 duty)
+{
+	if(OCR0 != duty)
+	{
+		OCR0 = duty ;
+	}
 }
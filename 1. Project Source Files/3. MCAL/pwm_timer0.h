@@ -17,24 +17,71 @@
 #include "std_types.h"
 #include "gpio.h"
 
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define PWM_OC0_PORT_ID				PORTB_ID
+#define PWM_OC0_PIN_ID				PIN3_ID
+
+#define PWM_MAXIMUM_DUTY			255
+
+/****************************************************************************
+ * 					          Types Declaration						        *
+ ****************************************************************************/
+typedef enum
+{
+	PWM_NON_INVERTING = 0x02,
+	PWM_INVERTING
+
+}PWM_Timer0_OutputMode;
+
+typedef enum
+{
+	PWM_F_CPU_CLOCK = 0x01,
+	PWM_F_CPU_8,
+	PWM_F_CPU_64,
+	PWM_F_CPU_256,
+	PWM_F_CPU_1024
+
+}PWM_Timer0_Prescaler;
+
+typedef struct
+{
+	PWM_Timer0_OutputMode output_mode;
+	PWM_Timer0_Prescaler prescaler;
+	uint8 duty;		/* Initial compare value from 0 to PWM_MAXIMUM_DUTY */
+
+}PWM_Timer0_ConfigType;
+
 /****************************************************************************
  * 							Functions Prototypes						    *
  ****************************************************************************/
 
 /* Inputs:
- * 	1. duty_cycle: The required duty cycle percentage of the generated PWM signal.
+ * 	1. Pointer to the configuration structure with type PWM_Timer0_ConfigType.
  *
  * Return Value: void.
  *
  * Description:
- * 	The function responsible for trigger the Timer0 with the PWM Mode.
- * 	Setup the PWM mode with Non-Inverting.
- * 	Setup the prescaler with F_CPU/8.
- * 	Setup the compare value based on the required input duty cycle.
+ * 	The function responsible for start the Timer0 with the Fast PWM Mode, it should be called once.
+ * 	Setup the PWM output mode and the prescaler from the configuration.
+ * 	Setup the initial compare value.
  *	Setup the direction for OC0 as output pin through the GPIO driver.
- *	The generated PWM signal frequency will be 500Hz to control the DC Motor speed.
+ *	With F_CPU = 1MHz and F_CPU/8 prescaler the PWM signal frequency is about 500Hz.
+ */
+void PWM_Timer0_Init(const PWM_Timer0_ConfigType * Config_Ptr);
+
+/* Inputs:
+ * 	1. duty: The required compare value from 0 to PWM_MAXIMUM_DUTY.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	The function responsible for change the duty cycle of the running PWM signal.
+ * 	OCR0 is written only if the value changes, the hardware double buffers it
+ * 	until the end of the current period, so the update never cuts a period.
  */
-void PWM_Timer0_Start(float duty_cycle);
+void PWM_Timer0_SetDuty(uint8 duty);
 
 
 #endif /* PWM_TIMER0_H_ */
@@ -0,0 +1,57 @@
+/*
+ ============================================================================
+ Name        : pwm_timer2.c
+ Author      : Ahmed Shawky
+ Description : Source File for PWM Driver using Timer 2
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "pwm_timer2.h"
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. Pointer to the configuration structure with type PWM_Timer2_ConfigType.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	The function responsible for start the Timer2 with the Fast PWM Mode, it should be called once.
+ * 	Setup the PWM output mode and the prescaler from the configuration.
+ * 	Setup the initial compare value.
+ *	Setup the direction for OC2 as output pin through the GPIO driver.
+ */
+void PWM_Timer2_Init(const PWM_Timer2_ConfigType * Config_Ptr)
+{
+	GPIO_STATIC_SETUP_PIN_DIRECTION(PWM_OC2_PORT_ID, PWM_OC2_PIN_ID, PIN_OUTPUT);
+
+	TCNT2 = 0 ;
+
+	OCR2 = Config_Ptr->duty ;
+
+	/* Fast PWM mode, the output mode in COM21:0 and the prescaler in CS22:0 */
+	TCCR2 = (1<<WGM20) | (1<<WGM21) | ( Config_Ptr->output_mode << COM20 ) | ( Config_Ptr->prescaler ) ;
+}
+
+/* Inputs:
+ * 	1. duty: The required compare value from 0 to 255.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	The function responsible for change the duty cycle of the running PWM signal.
+ * 	OCR2 is written only if the value changes, it is double buffered like OCR0.
+ */
+void PWM_Timer2_SetDuty(uint8 duty)
+{
+	if(OCR2 != duty)
+	{
+		OCR2 = duty ;
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ ============================================================================
+ Name        : pwm_timer2.h
+ Author      : Ahmed Shawky
+ Description : Header File for PWM Driver using Timer 2
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef PWM_TIMER2_H_
+#define PWM_TIMER2_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+#include "std_types.h"
+#include "gpio.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define PWM_OC2_PORT_ID				PORTD_ID
+#define PWM_OC2_PIN_ID				PIN7_ID
+
+/****************************************************************************
+ * 					          Types Declaration						        *
+ ****************************************************************************/
+typedef enum
+{
+	PWM2_NON_INVERTING = 0x02,
+	PWM2_INVERTING
+
+}PWM_Timer2_OutputMode;
+
+/* Timer2 has its own prescaler values, they are not the same as Timer0 */
+typedef enum
+{
+	PWM2_F_CPU_CLOCK = 0x01,
+	PWM2_F_CPU_8,
+	PWM2_F_CPU_32,
+	PWM2_F_CPU_64,
+	PWM2_F_CPU_128,
+	PWM2_F_CPU_256,
+	PWM2_F_CPU_1024
+
+}PWM_Timer2_Prescaler;
+
+typedef struct
+{
+	PWM_Timer2_OutputMode output_mode;
+	PWM_Timer2_Prescaler prescaler;
+	uint8 duty;		/* Initial compare value from 0 to 255 */
+
+}PWM_Timer2_ConfigType;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. Pointer to the configuration structure with type PWM_Timer2_ConfigType.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	The function responsible for start the Timer2 with the Fast PWM Mode, it should be called once.
+ * 	Setup the PWM output mode and the prescaler from the configuration.
+ * 	Setup the initial compare value.
+ *	Setup the direction for OC2 as output pin through the GPIO driver.
+ */
+void PWM_Timer2_Init(const PWM_Timer2_ConfigType * Config_Ptr);
+
+/* Inputs:
+ * 	1. duty: The required compare value from 0 to 255.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	The function responsible for change the duty cycle of the running PWM signal.
+ * 	OCR2 is written only if the value changes, it is double buffered like OCR0.
+ */
+void PWM_Timer2_SetDuty(uint8 duty);
+
+
+#endif /* PWM_TIMER2_H_ */
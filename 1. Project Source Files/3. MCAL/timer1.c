@@ -0,0 +1,291 @@
+/*
+ ============================================================================
+ Name        : timer1.c
+ Author      : Ahmed Shawky
+ Description : Source File for Timer1 Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/interrupt.h>
+#include "timer1.h"
+
+#if (TIMER1_PRESCALER == 1)
+#define TIMER1_CLOCK_SELECT			(1<<CS10)
+#elif (TIMER1_PRESCALER == 8)
+#define TIMER1_CLOCK_SELECT			(1<<CS11)
+#elif (TIMER1_PRESCALER == 64)
+#define TIMER1_CLOCK_SELECT			((1<<CS11) | (1<<CS10))
+#elif (TIMER1_PRESCALER == 256)
+#define TIMER1_CLOCK_SELECT			(1<<CS12)
+#elif (TIMER1_PRESCALER == 1024)
+#define TIMER1_CLOCK_SELECT			((1<<CS12) | (1<<CS10))
+#else
+#error "TIMER1_PRESCALER should be 1, 8, 64, 256 or 1024"
+#endif
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static void (*volatile g_timer1_compareACallBack)(void) = NULL_PTR ;
+static volatile uint16 g_timer1_compareAInterval = 0 ;
+static void (*volatile g_timer1_compareBCallBack)(void) = NULL_PTR ;
+static volatile uint16 g_timer1_compareBInterval = 0 ;
+static void (*volatile g_timer1_captureCallBack)(uint32 timestamp) = NULL_PTR ;
+
+/* High 16 bits of the extended counter */
+static volatile uint16 g_timer1_overflows = 0 ;
+
+/****************************************************************************
+ * 						  Private Functions Prototypes					    *
+ ****************************************************************************/
+static uint32 Timer1_extend(uint16 count);
+
+/****************************************************************************
+ * 						   Interrupt Service Routines					    *
+ ****************************************************************************/
+ISR(TIMER1_COMPA_vect)
+{
+	/* Schedule the next compare match */
+	OCR1A += g_timer1_compareAInterval ;
+
+	if(g_timer1_compareACallBack != NULL_PTR)
+	{
+		(*g_timer1_compareACallBack)();
+	}
+}
+
+ISR(TIMER1_CAPT_vect)
+{
+	/* ICR1 holds the counter at the edge */
+	uint32 timestamp = Timer1_extend(ICR1) ;
+
+	if(g_timer1_captureCallBack != NULL_PTR)
+	{
+		(*g_timer1_captureCallBack)(timestamp);
+	}
+}
+
+ISR(TIMER1_OVF_vect)
+{
+	g_timer1_overflows++ ;
+}
+
+ISR(TIMER1_COMPB_vect)
+{
+	/* Schedule the next compare match */
+	OCR1B += g_timer1_compareBInterval ;
+
+	if(g_timer1_compareBCallBack != NULL_PTR)
+	{
+		(*g_timer1_compareBCallBack)();
+	}
+}
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for start Timer1 counting in normal mode with the configured prescaler.
+ * 	Timer1 is shared between several drivers, so it is started only once and
+ * 	the next calls will not reset the counter.
+ * 	The overflow interrupt counts the counter wraps to extend it to 32 bits.
+ */
+void Timer1_init(void)
+{
+	if(0 == (TCCR1B & 0x07))
+	{
+		/* Normal mode, OC1A and OC1B disconnected */
+		TCCR1A = 0 ;
+		TCNT1 = 0 ;
+		TCCR1B = TIMER1_CLOCK_SELECT ;
+
+		TIFR = (1<<TOV1) ;
+		TIMSK |= (1<<TOIE1) ;
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: The current Timer1 counter value.
+ *
+ * Description:
+ * 	Function responsible for read the 16-bit counter register safely.
+ */
+uint16 Timer1_getCounter(void)
+{
+	uint16 count ;
+	uint8 sreg = SREG ;
+
+	/* The 16-bit read uses the shared TEMP register, so it must not be interrupted */
+	cli();
+	count = TCNT1 ;
+	SREG = sreg ;
+
+	return count ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: The 32-bit Timer1 time, the counter with its overflows count.
+ *
+ * Description:
+ * 	Function responsible for read the extended counter, it has the same time base as the captures.
+ */
+uint32 Timer1_getTimestamp(void)
+{
+	uint32 timestamp ;
+	uint8 sreg = SREG ;
+
+	cli();
+	timestamp = Timer1_extend(TCNT1) ;
+	SREG = sreg ;
+
+	return timestamp ;
+}
+
+/* Inputs:
+ * 	1. interval: number of Timer1 counts between two calls of the call back function.
+ * 	2. a_ptr   : pointer to the call back function.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for call the required function periodically from the compare A interrupt.
+ * 	It works the same as Timer1_startCompareB.
+ */
+void Timer1_startCompareA(uint16 interval, void(*a_ptr)(void))
+{
+	uint8 sreg = SREG ;
+
+	cli();
+	g_timer1_compareACallBack = a_ptr ;
+	g_timer1_compareAInterval = interval ;
+	OCR1A = TCNT1 + interval ;
+
+	/* Clear any old compare flag then enable the interrupt */
+	TIFR = (1<<OCF1A) ;
+	TIMSK |= (1<<OCIE1A) ;
+	SREG = sreg ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for disable the compare A interrupt.
+ */
+void Timer1_stopCompareA(void)
+{
+	TIMSK &= ~(1<<OCIE1A) ;
+}
+
+/* Inputs:
+ * 	1. interval: number of Timer1 counts between two calls of the call back function.
+ * 	2. a_ptr   : pointer to the call back function.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for call the required function periodically from the compare B interrupt.
+ * 	The compare B value is moved forward by the interval in each interrupt,
+ * 	so the counter keeps running freely for the other Timer1 users.
+ */
+void Timer1_startCompareB(uint16 interval, void(*a_ptr)(void))
+{
+	uint8 sreg = SREG ;
+
+	cli();
+	g_timer1_compareBCallBack = a_ptr ;
+	g_timer1_compareBInterval = interval ;
+	OCR1B = TCNT1 + interval ;
+
+	/* Clear any old compare flag then enable the interrupt */
+	TIFR = (1<<OCF1B) ;
+	TIMSK |= (1<<OCIE1B) ;
+	SREG = sreg ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for disable the compare B interrupt.
+ */
+void Timer1_stopCompareB(void)
+{
+	TIMSK &= ~(1<<OCIE1B) ;
+}
+
+/* Inputs:
+ * 	1. edge : the edge of the ICP1 pin which is captured.
+ * 	2. a_ptr: pointer to the call back function, it takes the 32-bit time of the edge.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for call the required function from the input capture interrupt.
+ * 	The hardware copies the counter to ICR1 at the edge, so the time does not depend on the interrupt latency.
+ * 	The noise canceler is enabled, it delays the capture by 4 clocks.
+ */
+void Timer1_startCapture(Timer1_CaptureEdge edge, void(*a_ptr)(uint32 timestamp))
+{
+	uint8 sreg = SREG ;
+
+	cli();
+	g_timer1_captureCallBack = a_ptr ;
+	TCCR1B = (TCCR1B & ~(1<<ICES1)) | (1<<ICNC1) | (edge << ICES1) ;
+
+	/* Changing the edge may set the capture flag, clear it then enable the interrupt */
+	TIFR = (1<<ICF1) ;
+	TIMSK |= (1<<TICIE1) ;
+	SREG = sreg ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for disable the input capture interrupt.
+ */
+void Timer1_stopCapture(void)
+{
+	TIMSK &= ~(1<<TICIE1) ;
+}
+
+/****************************************************************************
+ * 						   Private Functions Definitions				    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. count: a Timer1 counter value read with the interrupts disabled.
+ *
+ * Return Value: The 32-bit time of this counter value.
+ *
+ * Description:
+ * 	Function responsible for add the overflows count to the counter value.
+ * 	An overflow which is still pending belongs to the counter value only if the value is
+ * 	in the first half of the counter range, the value was read after the counter wrapped.
+ */
+static uint32 Timer1_extend(uint16 count)
+{
+	uint16 overflows = g_timer1_overflows ;
+
+	if((TIFR & (1<<TOV1)) && (count < 0x8000))
+	{
+		overflows++ ;
+	}
+
+	return ((uint32)overflows << 16) | count ;
+}
@@ -0,0 +1,143 @@
+/*
+ ============================================================================
+ Name        : timer1.h
+ Author      : Ahmed Shawky
+ Description : Header File for Timer1 Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef TIMER1_H_
+#define TIMER1_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+#include "std_types.h"
+#include "common_macros.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#ifndef F_CPU
+#define F_CPU 						1000000UL
+#endif
+
+/* Timer1 clock prescaler, it should be 1, 8, 64, 256 or 1024 */
+#define TIMER1_PRESCALER			1
+
+/* Convert a time in microseconds to Timer1 counts */
+#define TIMER1_US_TO_TICKS(us)		((uint32)(((uint64)(us) * (F_CPU / 1000000UL)) / TIMER1_PRESCALER))
+
+/****************************************************************************
+ * 					          Types Declaration						        *
+ ****************************************************************************/
+typedef enum
+{
+	TIMER1_FALLING_EDGE,
+	TIMER1_RISING_EDGE
+
+}Timer1_CaptureEdge;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for start Timer1 counting in normal mode with the configured prescaler.
+ * 	Timer1 is shared between several drivers, so it is started only once and
+ * 	the next calls will not reset the counter.
+ * 	The overflow interrupt counts the counter wraps to extend it to 32 bits.
+ */
+void Timer1_init(void);
+
+/* Inputs: void.
+ *
+ * Return Value: The current Timer1 counter value.
+ *
+ * Description:
+ * 	Function responsible for read the 16-bit counter register safely.
+ */
+uint16 Timer1_getCounter(void);
+
+/* Inputs: void.
+ *
+ * Return Value: The 32-bit Timer1 time, the counter with its overflows count.
+ *
+ * Description:
+ * 	Function responsible for read the extended counter, it has the same time base as the captures.
+ */
+uint32 Timer1_getTimestamp(void);
+
+/* Inputs:
+ * 	1. interval: number of Timer1 counts between two calls of the call back function.
+ * 	2. a_ptr   : pointer to the call back function.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for call the required function periodically from the compare A interrupt.
+ * 	It works the same as Timer1_startCompareB.
+ */
+void Timer1_startCompareA(uint16 interval, void(*a_ptr)(void));
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for disable the compare A interrupt.
+ */
+void Timer1_stopCompareA(void);
+
+/* Inputs:
+ * 	1. interval: number of Timer1 counts between two calls of the call back function.
+ * 	2. a_ptr   : pointer to the call back function.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for call the required function periodically from the compare B interrupt.
+ * 	The compare B value is moved forward by the interval in each interrupt,
+ * 	so the counter keeps running freely for the other Timer1 users.
+ */
+void Timer1_startCompareB(uint16 interval, void(*a_ptr)(void));
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for disable the compare B interrupt.
+ */
+void Timer1_stopCompareB(void);
+
+/* Inputs:
+ * 	1. edge : the edge of the ICP1 pin which is captured.
+ * 	2. a_ptr: pointer to the call back function, it takes the 32-bit time of the edge.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for call the required function from the input capture interrupt.
+ * 	The hardware copies the counter to ICR1 at the edge, so the time does not depend on the interrupt latency.
+ * 	The noise canceler is enabled, it delays the capture by 4 clocks.
+ */
+void Timer1_startCapture(Timer1_CaptureEdge edge, void(*a_ptr)(uint32 timestamp));
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for disable the input capture interrupt.
+ */
+void Timer1_stopCapture(void);
+
+
+#endif /* TIMER1_H_ */
@@ -0,0 +1,152 @@
+/*
+ ============================================================================
+ Name        : uart.c
+ Author      : Ahmed Shawky
+ Description : Source File for UART Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/interrupt.h>
+#include "uart.h"
+#include "ring_buffer.h"
+
+#if !RING_BUFFER_SIZE_IS_VALID(UART_TX_BUFFER_SIZE)
+#error "UART_TX_BUFFER_SIZE must be a power of two and not more than 128"
+#endif
+
+#if !RING_BUFFER_SIZE_IS_VALID(UART_RX_BUFFER_SIZE)
+#error "UART_RX_BUFFER_SIZE must be a power of two and not more than 128"
+#endif
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+
+/* The main loop produces the transmitted bytes and consumes the received ones, the ISRs do the opposite */
+static volatile uint8 g_uart_txBuffer[UART_TX_BUFFER_SIZE] ;
+static RingBuffer_Type g_uart_txRing ;
+
+static volatile uint8 g_uart_rxBuffer[UART_RX_BUFFER_SIZE] ;
+static RingBuffer_Type g_uart_rxRing ;
+
+/****************************************************************************
+ * 						   Interrupt Service Routines					    *
+ ****************************************************************************/
+ISR(USART_UDRE_vect)
+{
+	uint8 data ;
+
+	if(RingBuffer_pop(&g_uart_txRing, &data))
+	{
+		UDR = data ;
+	}
+	else
+	{
+		/* Nothing to send, the interrupt is enabled again by UART_send */
+		UCSRB &= ~(1<<UDRIE) ;
+	}
+}
+
+ISR(USART_RXC_vect)
+{
+	/* Reading UDR clears the interrupt flag, so it is read even if the byte is dropped */
+	uint8 data = UDR ;
+
+	RingBuffer_push(&g_uart_rxRing, &data);
+}
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. Pointer to the configuration structure with type UART_ConfigType.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for initialize the UART in double speed mode with the required baud rate,
+ * 	enable the transmitter and the receiver and the receive complete interrupt.
+ * 	With F_CPU = 1MHz the double speed mode gives 9600 baud with 0.2% error.
+ */
+void UART_init(const UART_ConfigType * Config_Ptr)
+{
+	/* Double speed: baud rate = F_CPU / (8 * (UBRR + 1)), rounded to the nearest value */
+	uint16 ubrr_value = (uint16)(((F_CPU + (4 * Config_Ptr->baud_rate)) / (8 * Config_Ptr->baud_rate)) - 1) ;
+
+	RingBuffer_init(&g_uart_txRing, g_uart_txBuffer, sizeof(uint8), UART_TX_BUFFER_SIZE);
+	RingBuffer_init(&g_uart_rxRing, g_uart_rxBuffer, sizeof(uint8), UART_RX_BUFFER_SIZE);
+
+	UCSRA = (1<<U2X) ;
+
+	/* 8 data bits, no parity and 1 stop bit, URSEL selects UCSRC */
+	UCSRC = (1<<URSEL) | (1<<UCSZ1) | (1<<UCSZ0) ;
+
+	UBRRH = (uint8)(ubrr_value >> 8) ;
+	UBRRL = (uint8)ubrr_value ;
+
+	UCSRB = (1<<RXCIE) | (1<<RXEN) | (1<<TXEN) ;
+}
+
+/* Inputs:
+ * 	1. data_ptr: pointer to the bytes to be sent.
+ * 	2. length  : number of bytes.
+ *
+ * Return Value: TRUE if all the bytes were queued, FALSE if there is no space for all of them.
+ *
+ * Description:
+ * 	Function responsible for queue the bytes in the transmit ring buffer, it never waits.
+ * 	The data register empty interrupt sends them in the background.
+ * 	Nothing is queued if the bytes do not fit, so a frame is never cut.
+ */
+boolean UART_send(const uint8 *data_ptr, uint8 length)
+{
+	boolean status = FALSE ;
+
+	/* The ISR can only free more space, so all the bytes fit after the check */
+	if((data_ptr != NULL_PTR) && (length <= RingBuffer_getFree(&g_uart_txRing)))
+	{
+		RingBuffer_pushBulk(&g_uart_txRing, data_ptr, length);
+		UCSRB |= (1<<UDRIE) ;
+		status = TRUE ;
+	}
+
+	return status ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: Number of free bytes in the transmit ring buffer.
+ *
+ * Description:
+ * 	Function responsible for return the space available for UART_send.
+ */
+uint8 UART_getTxSpace(void)
+{
+	return RingBuffer_getFree(&g_uart_txRing) ;
+}
+
+/* Inputs:
+ * 	1. Pointer to the variable which will hold the byte.
+ *
+ * Return Value: TRUE if a byte was read, FALSE if the receive buffer is empty.
+ *
+ * Description:
+ * 	Function responsible for read the oldest received byte, it never waits.
+ * 	The bytes received while the buffer is full are dropped.
+ */
+boolean UART_receiveByte(uint8 *data_ptr)
+{
+	boolean status = FALSE ;
+
+	if(data_ptr != NULL_PTR)
+	{
+		status = RingBuffer_pop(&g_uart_rxRing, data_ptr) ;
+	}
+
+	return status ;
+}
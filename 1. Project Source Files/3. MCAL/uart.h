@@ -0,0 +1,97 @@
+/*
+ ============================================================================
+ Name        : uart.h
+ Author      : Ahmed Shawky
+ Description : Header File for UART Driver
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef UART_H_
+#define UART_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+#include "gpio.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#ifndef F_CPU
+#define F_CPU 						1000000UL
+#endif
+
+/* USART pins, the receiver and the transmitter take them from the GPIO when they are enabled,
+ * so no other driver can use them */
+#define UART_PORT_ID				PORTD_ID
+#define UART_RXD_PIN_ID				PIN0_ID
+#define UART_TXD_PIN_ID				PIN1_ID
+
+/* Ring buffers sizes, they must be powers of two (max 128) */
+#define UART_TX_BUFFER_SIZE			64
+#define UART_RX_BUFFER_SIZE			16
+
+/****************************************************************************
+ * 					          Types Declaration						        *
+ ****************************************************************************/
+typedef struct
+{
+	uint32 baud_rate;	/* The frame is 8 data bits, no parity and 1 stop bit */
+
+}UART_ConfigType;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. Pointer to the configuration structure with type UART_ConfigType.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for initialize the UART in double speed mode with the required baud rate,
+ * 	enable the transmitter and the receiver and the receive complete interrupt.
+ * 	With F_CPU = 1MHz the double speed mode gives 9600 baud with 0.2% error.
+ */
+void UART_init(const UART_ConfigType * Config_Ptr);
+
+/* Inputs:
+ * 	1. data_ptr: pointer to the bytes to be sent.
+ * 	2. length  : number of bytes.
+ *
+ * Return Value: TRUE if all the bytes were queued, FALSE if there is no space for all of them.
+ *
+ * Description:
+ * 	Function responsible for queue the bytes in the transmit ring buffer, it never waits.
+ * 	The data register empty interrupt sends them in the background.
+ * 	Nothing is queued if the bytes do not fit, so a frame is never cut.
+ */
+boolean UART_send(const uint8 *data_ptr, uint8 length);
+
+/* Inputs: void.
+ *
+ * Return Value: Number of free bytes in the transmit ring buffer.
+ *
+ * Description:
+ * 	Function responsible for return the space available for UART_send.
+ */
+uint8 UART_getTxSpace(void);
+
+/* Inputs:
+ * 	1. Pointer to the variable which will hold the byte.
+ *
+ * Return Value: TRUE if a byte was read, FALSE if the receive buffer is empty.
+ *
+ * Description:
+ * 	Function responsible for read the oldest received byte, it never waits.
+ * 	The bytes received while the buffer is full are dropped.
+ */
+boolean UART_receiveByte(uint8 *data_ptr);
+
+
+#endif /* UART_H_ */
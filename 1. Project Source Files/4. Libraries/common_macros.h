@@ -33,4 +33,7 @@
 
 #define GET_BIT(REG,BIT) ( ( REG & (1<<BIT) ) >> BIT )
 
+/* Evaluate to ZERO if the condition is a true constant expression, otherwise stop the compilation */
+#define STATIC_CHECK_ZERO(COND) ( sizeof(struct { int static_check_failed : ((COND) ? 1 : -1); }) * 0 )
+
 #endif /* COMMON_MACROS_H_ */
@@ -0,0 +1,61 @@
+/*
+ ============================================================================
+ Name        : crc16.c
+ Author      : Ahmed Shawky
+ Description : Source File for the CRC-16/CCITT Calculation
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "crc16.h"
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. crc : the CRC of the previous bytes, CRC16_INITIAL_VALUE for the first byte.
+ * 	2. data: the next byte.
+ *
+ * Return Value: The CRC including the byte.
+ *
+ * Description:
+ * 	Function responsible for add one byte to the CRC with shifts and XORs only,
+ * 	it needs no table and no loop over the bits.
+ */
+uint16 CRC16_update(uint16 crc, uint8 data)
+{
+	/* The 8 polynomial divisions of the byte folded into the terms x^12 and x^5 of 0x1021 */
+	crc = (uint16)((crc >> 8) | (crc << 8)) ;
+	crc ^= data ;
+	crc ^= (uint8)(crc & 0xFF) >> 4 ;
+	crc ^= (uint16)(crc << 12) ;
+	crc ^= (uint16)((crc & 0xFF) << 5) ;
+
+	return crc ;
+}
+
+/* Inputs:
+ * 	1. data_ptr: pointer to the bytes.
+ * 	2. length  : number of bytes.
+ *
+ * Return Value: The CRC of the bytes.
+ *
+ * Description:
+ * 	Function responsible for calculate the CRC of a buffer from CRC16_INITIAL_VALUE.
+ */
+uint16 CRC16_compute(const uint8 *data_ptr, uint8 length)
+{
+	uint16 crc = CRC16_INITIAL_VALUE ;
+	uint8 index ;
+
+	for(index = 0 ; index < length ; index++)
+	{
+		crc = CRC16_update(crc, data_ptr[index]) ;
+	}
+
+	return crc ;
+}
@@ -0,0 +1,53 @@
+/*
+ ============================================================================
+ Name        : crc16.h
+ Author      : Ahmed Shawky
+ Description : Header File for the CRC-16/CCITT Calculation
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* CRC-16/CCITT-FALSE: polynomial 0x1021, no reflection, no final XOR, "123456789" gives 0x29B1 */
+#define CRC16_INITIAL_VALUE			0xFFFF
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. crc : the CRC of the previous bytes, CRC16_INITIAL_VALUE for the first byte.
+ * 	2. data: the next byte.
+ *
+ * Return Value: The CRC including the byte.
+ *
+ * Description:
+ * 	Function responsible for add one byte to the CRC with shifts and XORs only,
+ * 	it needs no table and no loop over the bits.
+ */
+uint16 CRC16_update(uint16 crc, uint8 data);
+
+/* Inputs:
+ * 	1. data_ptr: pointer to the bytes.
+ * 	2. length  : number of bytes.
+ *
+ * Return Value: The CRC of the bytes.
+ *
+ * Description:
+ * 	Function responsible for calculate the CRC of a buffer from CRC16_INITIAL_VALUE.
+ */
+uint16 CRC16_compute(const uint8 *data_ptr, uint8 length);
+
+
+#endif /* CRC16_H_ */
@@ -0,0 +1,124 @@
+/*
+ ============================================================================
+ Name        : pid_controller.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Fixed Point PID Controller
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "pid_controller.h"
+
+/****************************************************************************
+ * 						Private Functions Prototypes					    *
+ ****************************************************************************/
+static sint32 PID_clamp(sint32 value, sint32 min, sint32 max);
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: pid: pointer to the controller.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for clear the integral and derivative history of the controller.
+ */
+void PID_reset(PID_ControllerType *pid)
+{
+	pid->integral = 0 ;
+	pid->last_input = 0 ;
+	pid->started = FALSE ;
+}
+
+/* Inputs:
+ * 	1. pid  : pointer to the controller.
+ * 	2. input: the measured value in the setpoint units.
+ *
+ * Return Value: The controller output between output_min and output_max.
+ *
+ * Description:
+ * 	Function responsible for calculate the next output, it should be called each sample period.
+ * 	The derivative uses the input change, so a setpoint change does not kick the output.
+ * 	The integral is clamped to the output range and stops while the output is saturated (anti-windup).
+ */
+uint8 PID_update(PID_ControllerType *pid, sint16 input)
+{
+	sint32 out_min = (sint32)pid->output_min << PID_GAIN_SHIFT ;
+	sint32 out_max = (sint32)pid->output_max << PID_GAIN_SHIFT ;
+	sint32 error ;
+	sint32 change ;
+	sint32 proportional ;
+	sint32 derivative ;
+	sint32 integral ;
+	sint32 output ;
+
+	if(FALSE == pid->started)
+	{
+		/* No input history, the first derivative is zero */
+		pid->last_input = input ;
+		pid->started = TRUE ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	if(PID_COOLING == pid->direction)
+	{
+		error = (sint32)input - pid->setpoint ;
+		change = (sint32)input - pid->last_input ;
+	}
+	else
+	{
+		error = (sint32)pid->setpoint - input ;
+		change = (sint32)pid->last_input - input ;
+	}
+	pid->last_input = input ;
+
+	proportional = PID_clamp(pid->kp * error, -PID_TERM_LIMIT, PID_TERM_LIMIT) ;
+	derivative = PID_clamp(pid->kd * change, -PID_TERM_LIMIT, PID_TERM_LIMIT) ;
+
+	/* Integrate only when it does not push the saturated output further */
+	integral = PID_clamp(pid->integral + (pid->ki * error), out_min, out_max) ;
+	output = proportional + pid->integral + derivative ;
+	if(((output >= out_max) && (integral > pid->integral)) ||
+	   ((output <= out_min) && (integral < pid->integral)))
+	{
+		/* Keep the old integral */
+	}
+	else
+	{
+		pid->integral = integral ;
+	}
+
+	output = PID_clamp(proportional + pid->integral + derivative, out_min, out_max) ;
+
+	/* Round the Q16 output to the nearest step */
+	return (uint8)((output + (1L << (PID_GAIN_SHIFT - 1))) >> PID_GAIN_SHIFT) ;
+}
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+static sint32 PID_clamp(sint32 value, sint32 min, sint32 max)
+{
+	if(value > max)
+	{
+		value = max ;
+	}
+	else if(value < min)
+	{
+		value = min ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return value ;
+}
@@ -0,0 +1,87 @@
+/*
+ ============================================================================
+ Name        : pid_controller.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Fixed Point PID Controller
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef PID_CONTROLLER_H_
+#define PID_CONTROLLER_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The gains are Q16 fixed point numbers, 65536 is a gain of 1.0 output step per input unit.
+ * Use it with constant values only, so the floating point is calculated by the compiler */
+#define PID_GAIN_SHIFT				16
+#define PID_GAIN(value)				((sint32)((value) * (1UL << PID_GAIN_SHIFT) + 0.5))
+
+/* Limit of each term before the sum, far above the output range, so the sum can not overflow */
+#define PID_TERM_LIMIT				((sint32)1 << 26)
+
+/* Initializer of a controller configuration, the state starts cleared */
+#define PID_CONTROLLER(kp, ki, kd, setpoint, direction, output_min, output_max) \
+	{(kp), (ki), (kd), (setpoint), (direction), (output_min), (output_max), 0, 0, FALSE}
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef enum
+{
+	PID_HEATING,	/* output rises when the input is below the setpoint */
+	PID_COOLING		/* output rises when the input is above the setpoint */
+}PID_Direction;
+
+typedef struct
+{
+	/* Configuration, the gains should keep |gain * input error| below 2^31 */
+	sint32 kp ;
+	sint32 ki ;				/* multiplied by the sample period */
+	sint32 kd ;				/* divided by the sample period */
+	sint16 setpoint ;
+	PID_Direction direction ;
+	uint8 output_min ;
+	uint8 output_max ;
+
+	/* State, it is cleared by PID_reset */
+	sint32 integral ;		/* Q16 output units */
+	sint16 last_input ;
+	boolean started ;
+}PID_ControllerType;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs: pid: pointer to the controller.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for clear the integral and derivative history of the controller.
+ */
+void PID_reset(PID_ControllerType *pid);
+
+/* Inputs:
+ * 	1. pid  : pointer to the controller.
+ * 	2. input: the measured value in the setpoint units.
+ *
+ * Return Value: The controller output between output_min and output_max.
+ *
+ * Description:
+ * 	Function responsible for calculate the next output, it should be called each sample period.
+ * 	The derivative uses the input change, so a setpoint change does not kick the output.
+ * 	The integral is clamped to the output range and stops while the output is saturated (anti-windup).
+ */
+uint8 PID_update(PID_ControllerType *pid, sint16 input);
+
+
+#endif /* PID_CONTROLLER_H_ */
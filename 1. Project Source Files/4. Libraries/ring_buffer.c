@@ -0,0 +1,366 @@
+/*
+ ============================================================================
+ Name        : ring_buffer.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Single Producer Single Consumer Ring Buffer
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "ring_buffer.h"
+
+/****************************************************************************
+ * 						Private Functions Prototypes					    *
+ ****************************************************************************/
+static void RingBuffer_write(RingBuffer_Type *rb, uint8 index, const uint8 *source);
+static void RingBuffer_read(const RingBuffer_Type *rb, uint8 index, uint8 *destination);
+static uint8 RingBuffer_validTail(const RingBuffer_Type *rb, uint8 head);
+static uint8 RingBuffer_staleCount(const RingBuffer_Type *rb, uint8 tail, uint8 count);
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. rb          : pointer to the ring buffer.
+ * 	2. storage     : array of size elements.
+ * 	3. element_size: size of one element in bytes.
+ * 	4. size        : number of elements, see RING_BUFFER_SIZE_IS_VALID.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for attach the storage to the ring buffer and make it empty.
+ * 	It should be called before the producer and the consumer start.
+ */
+void RingBuffer_init(RingBuffer_Type *rb, volatile void *storage, uint8 element_size, uint8 size)
+{
+	rb->buffer = (volatile uint8 *)storage ;
+	rb->element_size = element_size ;
+	rb->mask = size - 1 ;
+	rb->head = 0 ;
+	rb->tail = 0 ;
+	rb->overwrite = FALSE ;
+}
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. element: pointer to the element to be copied in the buffer.
+ *
+ * Return Value: TRUE if the element was stored, FALSE if the buffer is full.
+ *
+ * Description:
+ * 	Producer function, the unread elements are never changed.
+ */
+boolean RingBuffer_push(RingBuffer_Type *rb, const void *element)
+{
+	boolean status = FALSE ;
+	uint8 head = rb->head ;
+
+	if((uint8)(head - rb->tail) <= rb->mask)
+	{
+		RingBuffer_write(rb, head, (const uint8 *)element);
+
+		/* Publish the element after it is complete */
+		rb->head = head + 1 ;
+		status = TRUE ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return status ;
+}
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. element: pointer to the element to be copied in the buffer.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Producer function for the sampled data where the newest element matters more than the oldest.
+ * 	When the buffer is full the oldest unread element is overwritten, RingBuffer_pop skips it.
+ * 	The newest (size - 1) elements can be read, the slot at the head is the next one the producer writes.
+ * 	The consumer should pop at least once every (256 - size) pushes, otherwise the 8-bit
+ * 	indexes wrap and the number of the unread elements is wrong.
+ */
+void RingBuffer_pushOverwrite(RingBuffer_Type *rb, const void *element)
+{
+	uint8 head = rb->head ;
+
+	/* Tell the consumer before the first write which can reach its slot */
+	rb->overwrite = TRUE ;
+	RingBuffer_write(rb, head, (const uint8 *)element);
+	rb->head = head + 1 ;
+}
+
+/* Inputs:
+ * 	1. rb      : pointer to the ring buffer.
+ * 	2. elements: pointer to the array of the elements to be copied in the buffer.
+ * 	3. count   : number of elements.
+ *
+ * Return Value: Number of the stored elements, it is less than count if the buffer becomes full.
+ *
+ * Description:
+ * 	Producer function, the stored elements are published together by one head update.
+ */
+uint8 RingBuffer_pushBulk(RingBuffer_Type *rb, const void *elements, uint8 count)
+{
+	const uint8 *source = (const uint8 *)elements ;
+	uint8 head = rb->head ;
+	uint8 space = RingBuffer_getFree(rb) ;
+	uint8 index ;
+
+	count = (count > space) ? space : count ;
+	for(index = 0 ; index < count ; index++)
+	{
+		RingBuffer_write(rb, head + index, source);
+		source += rb->element_size ;
+	}
+	rb->head = head + count ;
+
+	return count ;
+}
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. element: pointer to the variable which will hold the element.
+ *
+ * Return Value: TRUE if an element was read, FALSE if the buffer is empty.
+ *
+ * Description:
+ * 	Consumer function, it reads the oldest unread element.
+ * 	After an overwrite it continues from the oldest element which is still stored,
+ * 	an element overwritten while it is read is read again from the new oldest one.
+ */
+boolean RingBuffer_pop(RingBuffer_Type *rb, void *element)
+{
+	boolean status ;
+	uint8 head ;
+	uint8 tail ;
+
+	do
+	{
+		head = rb->head ;
+		tail = RingBuffer_validTail(rb, head) ;
+		status = (tail != head) ? TRUE : FALSE ;
+
+		if(TRUE == status)
+		{
+			RingBuffer_read(rb, tail, (uint8 *)element);
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}while((TRUE == status) && (0 != RingBuffer_staleCount(rb, tail, 1))) ;
+
+	if(TRUE == status)
+	{
+		/* Release the slot after it is read */
+		rb->tail = tail + 1 ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return status ;
+}
+
+/* Inputs:
+ * 	1. rb       : pointer to the ring buffer.
+ * 	2. elements : pointer to the array which will hold the elements.
+ * 	3. max_count: the array size in elements.
+ *
+ * Return Value: Number of the read elements.
+ *
+ * Description:
+ * 	Consumer function, the read elements are released together by one tail update.
+ * 	The oldest elements overwritten while they are read are dropped from the array.
+ */
+uint8 RingBuffer_popBulk(RingBuffer_Type *rb, void *elements, uint8 max_count)
+{
+	uint8 *destination = (uint8 *)elements ;
+	uint8 head ;
+	uint8 tail ;
+	uint8 count ;
+	uint8 stale ;
+	uint8 index ;
+	uint16 byte ;
+
+	do
+	{
+		head = rb->head ;
+		tail = RingBuffer_validTail(rb, head) ;
+		count = head - tail ;
+		count = (count > max_count) ? max_count : count ;
+		for(index = 0 ; index < count ; index++)
+		{
+			RingBuffer_read(rb, tail + index, destination + (uint16)index * rb->element_size);
+		}
+		stale = RingBuffer_staleCount(rb, tail, count) ;
+
+		/* Read again only if all of them were overwritten, so the caller does not see an empty buffer */
+	}while((0 != count) && (stale == count)) ;
+
+	/* Move the whole elements to the start of the array */
+	for(byte = 0 ; (0 != stale) && (byte < (uint16)(count - stale) * rb->element_size) ; byte++)
+	{
+		destination[byte] = destination[byte + (uint16)stale * rb->element_size] ;
+	}
+	rb->tail = tail + count ;
+
+	return count - stale ;
+}
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. age    : ZERO for the newest element, 1 for the one before it and so on.
+ * 	3. element: pointer to the variable which will hold the element.
+ *
+ * Return Value: TRUE if the element was read, FALSE if age is not less than the buffer size.
+ *
+ * Description:
+ * 	Function responsible for read a recent element without removing it, it is used as a history window.
+ * 	It does not know how many elements were pushed, the slots not written yet read as their initial value.
+ * 	The newest element stays valid until (size - 1) more pushes.
+ */
+boolean RingBuffer_peekNewest(const RingBuffer_Type *rb, uint8 age, void *element)
+{
+	boolean status = FALSE ;
+
+	if(age <= rb->mask)
+	{
+		RingBuffer_read(rb, rb->head - 1 - age, (uint8 *)element);
+		status = TRUE ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return status ;
+}
+
+/* Inputs: rb: pointer to the ring buffer.
+ *
+ * Return Value: Number of the unread elements.
+ *
+ * Description:
+ * 	Function responsible for return the number of elements RingBuffer_pop can read now.
+ */
+uint8 RingBuffer_getCount(const RingBuffer_Type *rb)
+{
+	uint8 head = rb->head ;
+
+	return head - RingBuffer_validTail(rb, head) ;
+}
+
+/* Inputs: rb: pointer to the ring buffer.
+ *
+ * Return Value: Number of the free elements.
+ *
+ * Description:
+ * 	Function responsible for return the number of elements RingBuffer_push can store now.
+ * 	For the producer it is a lower limit, the consumer can only free more elements.
+ */
+uint8 RingBuffer_getFree(const RingBuffer_Type *rb)
+{
+	uint8 used = rb->head - rb->tail ;
+
+	return (used > rb->mask) ? 0 : (rb->mask + 1 - used) ;
+}
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Copy one element to the slot of the free running index */
+static void RingBuffer_write(RingBuffer_Type *rb, uint8 index, const uint8 *source)
+{
+	volatile uint8 *slot = rb->buffer + (uint16)(index & rb->mask) * rb->element_size ;
+	uint8 byte ;
+
+	for(byte = 0 ; byte < rb->element_size ; byte++)
+	{
+		slot[byte] = source[byte] ;
+	}
+}
+
+/* Copy one element from the slot of the free running index */
+static void RingBuffer_read(const RingBuffer_Type *rb, uint8 index, uint8 *destination)
+{
+	const volatile uint8 *slot = rb->buffer + (uint16)(index & rb->mask) * rb->element_size ;
+	uint8 byte ;
+
+	for(byte = 0 ; byte < rb->element_size ; byte++)
+	{
+		destination[byte] = slot[byte] ;
+	}
+}
+
+/* Inputs:
+ * 	1. rb  : pointer to the ring buffer.
+ * 	2. head: the head index read by the consumer.
+ *
+ * Return Value: The tail index of the oldest element which can be read.
+ *
+ * Description:
+ * 	Function responsible for skip the elements overwritten by RingBuffer_pushOverwrite.
+ * 	After an overwrite the slot at the head is skipped too, it is the next one the producer writes.
+ */
+static uint8 RingBuffer_validTail(const RingBuffer_Type *rb, uint8 head)
+{
+	uint8 tail = rb->tail ;
+
+	/* The overwrite producer writes the slot at the head next, with (size) unread elements it is the tail slot */
+	uint8 max_unread = (TRUE == rb->overwrite) ? rb->mask : (uint8)(rb->mask + 1) ;
+
+	if((uint8)(head - tail) > max_unread)
+	{
+		tail = head - rb->mask ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return tail ;
+}
+
+/* Inputs:
+ * 	1. rb   : pointer to the ring buffer.
+ * 	2. tail : the tail index of the first read element.
+ * 	3. count: number of the read elements.
+ *
+ * Return Value: Number of the first read elements the producer may have written while they were read.
+ *
+ * Description:
+ * 	Function responsible for check the elements after they are copied, it reads the head again.
+ * 	The slot at the new head may be in the middle of a write, so an element is whole only if
+ * 	its index is after (head - size). Only RingBuffer_pushOverwrite can write an unread slot.
+ */
+static uint8 RingBuffer_staleCount(const RingBuffer_Type *rb, uint8 tail, uint8 count)
+{
+	uint8 stale = 0 ;
+	uint8 used ;
+
+	if(TRUE == rb->overwrite)
+	{
+		used = rb->head - tail ;
+		stale = (used > rb->mask) ? (used - rb->mask) : 0 ;
+		stale = (stale > count) ? count : stale ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return stale ;
+}
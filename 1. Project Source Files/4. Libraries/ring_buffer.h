@@ -0,0 +1,160 @@
+/*
+ ============================================================================
+ Name        : ring_buffer.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Single Producer Single Consumer Ring Buffer
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef RING_BUFFER_H_
+#define RING_BUFFER_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The size is a number of elements, it must be a power of two and not more than 128,
+ * so the 8-bit free running indexes can tell a full buffer from an empty one.
+ * Use it in the users #if checks, the size is not checked at run time. */
+#define RING_BUFFER_SIZE_IS_VALID(size)		((((size) & ((size) - 1)) == 0) && ((size) != 0) && ((size) <= 128))
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+
+/* One context pushes and another one pops, for example an ISR and the main loop.
+ * Each index is written by one side only and an 8-bit write is atomic on AVR,
+ * the element is stored before the head moves and read before the tail moves, so no locking is needed. */
+typedef struct
+{
+	volatile uint8 *buffer ;	/* size * element_size bytes */
+	uint8 element_size ;
+	uint8 mask ;				/* size - 1 */
+	volatile uint8 head ;		/* written only by the producer */
+	volatile uint8 tail ;		/* written only by the consumer */
+	volatile boolean overwrite ;	/* set by RingBuffer_pushOverwrite, the producer may write the slot the consumer reads */
+}RingBuffer_Type;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. rb          : pointer to the ring buffer.
+ * 	2. storage     : array of size elements.
+ * 	3. element_size: size of one element in bytes.
+ * 	4. size        : number of elements, see RING_BUFFER_SIZE_IS_VALID.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for attach the storage to the ring buffer and make it empty.
+ * 	It should be called before the producer and the consumer start.
+ */
+void RingBuffer_init(RingBuffer_Type *rb, volatile void *storage, uint8 element_size, uint8 size);
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. element: pointer to the element to be copied in the buffer.
+ *
+ * Return Value: TRUE if the element was stored, FALSE if the buffer is full.
+ *
+ * Description:
+ * 	Producer function, the unread elements are never changed.
+ */
+boolean RingBuffer_push(RingBuffer_Type *rb, const void *element);
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. element: pointer to the element to be copied in the buffer.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Producer function for the sampled data where the newest element matters more than the oldest.
+ * 	When the buffer is full the oldest unread element is overwritten, RingBuffer_pop skips it.
+ * 	The newest (size - 1) elements can be read, the slot at the head is the next one the producer writes.
+ * 	The consumer should pop at least once every (256 - size) pushes, otherwise the 8-bit
+ * 	indexes wrap and the number of the unread elements is wrong.
+ */
+void RingBuffer_pushOverwrite(RingBuffer_Type *rb, const void *element);
+
+/* Inputs:
+ * 	1. rb      : pointer to the ring buffer.
+ * 	2. elements: pointer to the array of the elements to be copied in the buffer.
+ * 	3. count   : number of elements.
+ *
+ * Return Value: Number of the stored elements, it is less than count if the buffer becomes full.
+ *
+ * Description:
+ * 	Producer function, the stored elements are published together by one head update.
+ */
+uint8 RingBuffer_pushBulk(RingBuffer_Type *rb, const void *elements, uint8 count);
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. element: pointer to the variable which will hold the element.
+ *
+ * Return Value: TRUE if an element was read, FALSE if the buffer is empty.
+ *
+ * Description:
+ * 	Consumer function, it reads the oldest unread element.
+ * 	After an overwrite it continues from the oldest element which is still stored,
+ * 	an element overwritten while it is read is read again from the new oldest one.
+ */
+boolean RingBuffer_pop(RingBuffer_Type *rb, void *element);
+
+/* Inputs:
+ * 	1. rb       : pointer to the ring buffer.
+ * 	2. elements : pointer to the array which will hold the elements.
+ * 	3. max_count: the array size in elements.
+ *
+ * Return Value: Number of the read elements.
+ *
+ * Description:
+ * 	Consumer function, the read elements are released together by one tail update.
+ * 	The oldest elements overwritten while they are read are dropped from the array.
+ */
+uint8 RingBuffer_popBulk(RingBuffer_Type *rb, void *elements, uint8 max_count);
+
+/* Inputs:
+ * 	1. rb     : pointer to the ring buffer.
+ * 	2. age    : ZERO for the newest element, 1 for the one before it and so on.
+ * 	3. element: pointer to the variable which will hold the element.
+ *
+ * Return Value: TRUE if the element was read, FALSE if age is not less than the buffer size.
+ *
+ * Description:
+ * 	Function responsible for read a recent element without removing it, it is used as a history window.
+ * 	It does not know how many elements were pushed, the slots not written yet read as their initial value.
+ * 	The newest element stays valid until (size - 1) more pushes.
+ */
+boolean RingBuffer_peekNewest(const RingBuffer_Type *rb, uint8 age, void *element);
+
+/* Inputs: rb: pointer to the ring buffer.
+ *
+ * Return Value: Number of the unread elements.
+ *
+ * Description:
+ * 	Function responsible for return the number of elements RingBuffer_pop can read now.
+ */
+uint8 RingBuffer_getCount(const RingBuffer_Type *rb);
+
+/* Inputs: rb: pointer to the ring buffer.
+ *
+ * Return Value: Number of the free elements.
+ *
+ * Description:
+ * 	Function responsible for return the number of elements RingBuffer_push can store now.
+ * 	For the producer it is a lower limit, the consumer can only free more elements.
+ */
+uint8 RingBuffer_getFree(const RingBuffer_Type *rb);
+
+
+#endif /* RING_BUFFER_H_ */
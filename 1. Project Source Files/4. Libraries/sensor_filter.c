@@ -0,0 +1,114 @@
+/*
+ ============================================================================
+ Name        : sensor_filter.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Median and Exponential Moving Average Sensor Filter
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "sensor_filter.h"
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: filter: pointer to the filter.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for empty the median window, the next sample starts the average.
+ */
+void Filter_reset(Filter_StateType *filter)
+{
+	filter->next = 0 ;
+	filter->count = 0 ;
+	filter->average = 0 ;
+}
+
+/* Inputs:
+ * 	1. filter: pointer to the filter.
+ * 	2. sample: the new sensor reading.
+ *
+ * Return Value: The filtered value in the sample units.
+ *
+ * Description:
+ * 	Function responsible for add the sample to the sliding median window, then move the
+ * 	moving average toward the median. The oldest sample is removed from the sorted window
+ * 	and the new one is inserted in its place, so no full sort is needed.
+ * 	Before the window is full the median of the received samples is used.
+ */
+uint16 Filter_update(Filter_StateType *filter, uint16 sample)
+{
+	uint8 index ;
+	uint16 oldest ;
+	uint32 median ;
+
+	if(filter->count < FILTER_MEDIAN_SIZE)
+	{
+		/* The window grows, the sample is inserted after the used part */
+		index = filter->count ;
+		filter->count++ ;
+	}
+	else
+	{
+		/* Find the slot of the oldest sample in the sorted window */
+		oldest = filter->window[filter->next] ;
+		for(index = 0 ; filter->sorted[index] != oldest ; index++)
+		{
+			/* Do Nothing. */
+		}
+	}
+	filter->window[filter->next] = sample ;
+	filter->next = (filter->next + 1 < FILTER_MEDIAN_SIZE) ? (filter->next + 1) : 0 ;
+
+	/* Move the free slot up or down until the sample is in order */
+	while((index > 0) && (filter->sorted[index - 1] > sample))
+	{
+		filter->sorted[index] = filter->sorted[index - 1] ;
+		index-- ;
+	}
+	while((index + 1 < filter->count) && (filter->sorted[index + 1] < sample))
+	{
+		filter->sorted[index] = filter->sorted[index + 1] ;
+		index++ ;
+	}
+	filter->sorted[index] = sample ;
+
+	median = (uint32)Filter_getMedian(filter) << FILTER_EMA_FRACTION_BITS ;
+	if(1 == filter->count)
+	{
+		filter->average = median ;
+	}
+	else
+	{
+		/* average += (median - average) / 2^shift, the two directions keep it unsigned */
+		if(median >= filter->average)
+		{
+			filter->average += (median - filter->average) >> filter->ema_shift ;
+		}
+		else
+		{
+			filter->average -= (filter->average - median) >> filter->ema_shift ;
+		}
+	}
+
+	/* Round to the nearest sample unit */
+	return (uint16)((filter->average + (1UL << (FILTER_EMA_FRACTION_BITS - 1))) >> FILTER_EMA_FRACTION_BITS) ;
+}
+
+/* Inputs: filter: pointer to the filter.
+ *
+ * Return Value: The median of the window.
+ *
+ * Description:
+ * 	Function responsible for return the spike free value before the averaging.
+ */
+uint16 Filter_getMedian(const Filter_StateType *filter)
+{
+	return (filter->count != 0) ? filter->sorted[filter->count / 2] : 0 ;
+}
@@ -0,0 +1,86 @@
+/*
+ ============================================================================
+ Name        : sensor_filter.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Median and Exponential Moving Average Sensor Filter
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SENSOR_FILTER_H_
+#define SENSOR_FILTER_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "std_types.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* Median window, it should be odd, a spike shorter than (size + 1) / 2 samples is removed.
+ * Each update moves at most size - 1 values, so the update time is bounded */
+#define FILTER_MEDIAN_SIZE				5
+
+/* The average keeps this number of fraction bits, so the small steps are not lost */
+#define FILTER_EMA_FRACTION_BITS		8
+
+#if ((FILTER_MEDIAN_SIZE & 1) == 0) || (FILTER_MEDIAN_SIZE > 15)
+#error "FILTER_MEDIAN_SIZE should be odd and not more than 15"
+#endif
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef struct
+{
+	/* Configuration, the average weight of the new median is 1 / 2^ema_shift */
+	uint8 ema_shift ;
+
+	/* State, it is cleared by Filter_reset */
+	uint16 window[FILTER_MEDIAN_SIZE] ;		/* the last samples in their arrival order */
+	uint16 sorted[FILTER_MEDIAN_SIZE] ;		/* the same samples in ascending order */
+	uint8 next ;							/* window slot of the next sample */
+	uint8 count ;							/* samples in the window, until it is full */
+	uint32 average ;						/* FILTER_EMA_FRACTION_BITS fixed point */
+}Filter_StateType;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Inputs: filter: pointer to the filter.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for empty the median window, the next sample starts the average.
+ */
+void Filter_reset(Filter_StateType *filter);
+
+/* Inputs:
+ * 	1. filter: pointer to the filter.
+ * 	2. sample: the new sensor reading.
+ *
+ * Return Value: The filtered value in the sample units.
+ *
+ * Description:
+ * 	Function responsible for add the sample to the sliding median window, then move the
+ * 	moving average toward the median. The oldest sample is removed from the sorted window
+ * 	and the new one is inserted in its place, so no full sort is needed.
+ * 	Before the window is full the median of the received samples is used.
+ */
+uint16 Filter_update(Filter_StateType *filter, uint16 sample);
+
+/* Inputs: filter: pointer to the filter.
+ *
+ * Return Value: The median of the window.
+ *
+ * Description:
+ * 	Function responsible for return the spike free value before the averaging.
+ */
+uint16 Filter_getMedian(const Filter_StateType *filter);
+
+
+#endif /* SENSOR_FILTER_H_ */
@@ -0,0 +1,30 @@
+/*
+ ============================================================================
+ Name        : eeprom.h
+ Author      : Ahmed Shawky
+ Description : Host Simulation replacement of <avr/eeprom.h>
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_AVR_EEPROM_H_
+#define SIM_AVR_EEPROM_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdint.h>
+#include "sim.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The pointers are EEPROM addresses as in avr-libc, they are never used as host pointers */
+#define eeprom_read_byte(address)			Sim_eepromReadByte((uint16_t)(uintptr_t)(address))
+#define eeprom_read_word(address)			Sim_eepromReadWord((uint16_t)(uintptr_t)(address))
+#define eeprom_update_byte(address, value)	Sim_eepromUpdateByte((uint16_t)(uintptr_t)(address), (value))
+#define eeprom_update_word(address, value)	Sim_eepromUpdateWord((uint16_t)(uintptr_t)(address), (value))
+
+
+#endif /* SIM_AVR_EEPROM_H_ */
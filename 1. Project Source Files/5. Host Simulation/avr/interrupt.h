@@ -0,0 +1,29 @@
+/*
+ ============================================================================
+ Name        : interrupt.h
+ Author      : Ahmed Shawky
+ Description : Host Simulation replacement of <avr/interrupt.h>
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_AVR_INTERRUPT_H_
+#define SIM_AVR_INTERRUPT_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The ISR becomes a normal function, the simulator calls it when its flag and enable bits are set */
+#define ISR(vector, ...)		void vector(void); void vector(void)
+
+#define sei()					(SREG |= (1<<SREG_I))
+#define cli()					(SREG &= ~(1<<SREG_I))
+
+
+#endif /* SIM_AVR_INTERRUPT_H_ */
@@ -0,0 +1,233 @@
+/*
+ ============================================================================
+ Name        : io.h
+ Author      : Ahmed Shawky
+ Description : Host Simulation replacement of <avr/io.h> for ATmega32
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_AVR_IO_H_
+#define SIM_AVR_IO_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdint.h>
+#include "sim.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* Each register access goes through the simulator, so the peripherals models see every read and write */
+#define _SFR_IO8(io_addr)		(*Sim_accessRegister(io_addr))
+#define _SFR_IO16(io_addr)		(*Sim_accessRegister16(io_addr))
+
+/* I/O Registers */
+#define SREG		_SFR_IO8(0x3F)
+#define SPH			_SFR_IO8(0x3E)
+#define SPL			_SFR_IO8(0x3D)
+#define OCR0		_SFR_IO8(0x3C)
+#define GICR		_SFR_IO8(0x3B)
+#define GIFR		_SFR_IO8(0x3A)
+#define TIMSK		_SFR_IO8(0x39)
+#define TIFR		_SFR_IO8(0x38)
+#define SPMCR		_SFR_IO8(0x37)
+#define TWCR		_SFR_IO8(0x36)
+#define MCUCR		_SFR_IO8(0x35)
+#define MCUCSR		_SFR_IO8(0x34)
+#define TCCR0		_SFR_IO8(0x33)
+#define TCNT0		_SFR_IO8(0x32)
+#define OSCCAL		_SFR_IO8(0x31)
+#define SFIOR		_SFR_IO8(0x30)
+#define TCCR1A		_SFR_IO8(0x2F)
+#define TCCR1B		_SFR_IO8(0x2E)
+#define TCNT1		_SFR_IO16(0x2C)
+#define TCNT1L		_SFR_IO8(0x2C)
+#define TCNT1H		_SFR_IO8(0x2D)
+#define OCR1A		_SFR_IO16(0x2A)
+#define OCR1AL		_SFR_IO8(0x2A)
+#define OCR1AH		_SFR_IO8(0x2B)
+#define OCR1B		_SFR_IO16(0x28)
+#define OCR1BL		_SFR_IO8(0x28)
+#define OCR1BH		_SFR_IO8(0x29)
+#define ICR1		_SFR_IO16(0x26)
+#define ICR1L		_SFR_IO8(0x26)
+#define ICR1H		_SFR_IO8(0x27)
+#define TCCR2		_SFR_IO8(0x25)
+#define TCNT2		_SFR_IO8(0x24)
+#define OCR2		_SFR_IO8(0x23)
+#define ASSR		_SFR_IO8(0x22)
+#define WDTCR		_SFR_IO8(0x21)
+#define UBRRH		_SFR_IO8(0x20)
+#define UCSRC		_SFR_IO8(0x20)
+#define EEARH		_SFR_IO8(0x1F)
+#define EEARL		_SFR_IO8(0x1E)
+#define EEAR		_SFR_IO16(0x1E)
+#define EEDR		_SFR_IO8(0x1D)
+#define EECR		_SFR_IO8(0x1C)
+#define PORTA		_SFR_IO8(0x1B)
+#define DDRA		_SFR_IO8(0x1A)
+#define PINA		_SFR_IO8(0x19)
+#define PORTB		_SFR_IO8(0x18)
+#define DDRB		_SFR_IO8(0x17)
+#define PINB		_SFR_IO8(0x16)
+#define PORTC		_SFR_IO8(0x15)
+#define DDRC		_SFR_IO8(0x14)
+#define PINC		_SFR_IO8(0x13)
+#define PORTD		_SFR_IO8(0x12)
+#define DDRD		_SFR_IO8(0x11)
+#define PIND		_SFR_IO8(0x10)
+#define SPDR		_SFR_IO8(0x0F)
+#define SPSR		_SFR_IO8(0x0E)
+#define SPCR		_SFR_IO8(0x0D)
+#define UDR			_SFR_IO8(0x0C)
+#define UCSRA		_SFR_IO8(0x0B)
+#define UCSRB		_SFR_IO8(0x0A)
+#define UBRRL		_SFR_IO8(0x09)
+#define ACSR		_SFR_IO8(0x08)
+#define ADMUX		_SFR_IO8(0x07)
+#define ADCSRA		_SFR_IO8(0x06)
+#define ADC			_SFR_IO16(0x04)
+#define ADCW		_SFR_IO16(0x04)
+#define ADCL		_SFR_IO8(0x04)
+#define ADCH		_SFR_IO8(0x05)
+
+/* SREG */
+#define SREG_I		7
+
+/* TIMSK */
+#define OCIE2		7
+#define TOIE2		6
+#define TICIE1		5
+#define OCIE1A		4
+#define OCIE1B		3
+#define TOIE1		2
+#define OCIE0		1
+#define TOIE0		0
+
+/* TIFR */
+#define OCF2		7
+#define TOV2		6
+#define ICF1		5
+#define OCF1A		4
+#define OCF1B		3
+#define TOV1		2
+#define OCF0		1
+#define TOV0		0
+
+/* MCUCR */
+#define SE			7
+#define SM2			6
+#define SM1			5
+#define SM0			4
+
+/* TCCR0 */
+#define FOC0		7
+#define WGM00		6
+#define COM01		5
+#define COM00		4
+#define WGM01		3
+#define CS02		2
+#define CS01		1
+#define CS00		0
+
+/* SFIOR */
+#define ADTS2		7
+#define ADTS1		6
+#define ADTS0		5
+
+/* TCCR1A */
+#define COM1A1		7
+#define COM1A0		6
+#define COM1B1		5
+#define COM1B0		4
+#define FOC1A		3
+#define FOC1B		2
+#define WGM11		1
+#define WGM10		0
+
+/* TCCR1B */
+#define ICNC1		7
+#define ICES1		6
+#define WGM13		4
+#define WGM12		3
+#define CS12		2
+#define CS11		1
+#define CS10		0
+
+/* TCCR2 */
+#define FOC2		7
+#define WGM20		6
+#define COM21		5
+#define COM20		4
+#define WGM21		3
+#define CS22		2
+#define CS21		1
+#define CS20		0
+
+/* ASSR */
+#define AS2			3
+#define TCN2UB		2
+#define OCR2UB		1
+#define TCR2UB		0
+
+/* EECR */
+#define EERIE		3
+#define EEMWE		2
+#define EEWE		1
+#define EERE		0
+
+/* UCSRA */
+#define RXC			7
+#define TXC			6
+#define UDRE		5
+#define FE			4
+#define DOR			3
+#define PE			2
+#define U2X			1
+#define MPCM		0
+
+/* UCSRB */
+#define RXCIE		7
+#define TXCIE		6
+#define UDRIE		5
+#define RXEN		4
+#define TXEN		3
+#define UCSZ2		2
+#define RXB8		1
+#define TXB8		0
+
+/* UCSRC */
+#define URSEL		7
+#define UMSEL		6
+#define UPM1		5
+#define UPM0		4
+#define USBS		3
+#define UCSZ1		2
+#define UCSZ0		1
+#define UCPOL		0
+
+/* ADMUX */
+#define REFS1		7
+#define REFS0		6
+#define ADLAR		5
+#define MUX4		4
+#define MUX3		3
+#define MUX2		2
+#define MUX1		1
+#define MUX0		0
+
+/* ADCSRA */
+#define ADEN		7
+#define ADSC		6
+#define ADATE		5
+#define ADIF		4
+#define ADIE		3
+#define ADPS2		2
+#define ADPS1		1
+#define ADPS0		0
+
+
+#endif /* SIM_AVR_IO_H_ */
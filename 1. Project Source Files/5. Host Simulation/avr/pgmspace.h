@@ -0,0 +1,28 @@
+/*
+ ============================================================================
+ Name        : pgmspace.h
+ Author      : Ahmed Shawky
+ Description : Host Simulation replacement of <avr/pgmspace.h>
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_AVR_PGMSPACE_H_
+#define SIM_AVR_PGMSPACE_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdint.h>
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The host has one address space, the flash data is a normal constant */
+#define PROGMEM
+#define pgm_read_byte(address)			(*(const uint8_t *)(address))
+#define pgm_read_word(address)			(*(const uint16_t *)(address))
+
+
+#endif /* SIM_AVR_PGMSPACE_H_ */
@@ -0,0 +1,37 @@
+/*
+ ============================================================================
+ Name        : sleep.h
+ Author      : Ahmed Shawky
+ Description : Host Simulation replacement of <avr/sleep.h>
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_AVR_SLEEP_H_
+#define SIM_AVR_SLEEP_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define SLEEP_MODE_IDLE					0
+#define SLEEP_MODE_ADC					(1<<SM0)
+#define SLEEP_MODE_PWR_DOWN				(1<<SM1)
+#define SLEEP_MODE_PWR_SAVE				((1<<SM0) | (1<<SM1))
+#define SLEEP_MODE_STANDBY				((1<<SM1) | (1<<SM2))
+#define SLEEP_MODE_EXT_STANDBY			((1<<SM0) | (1<<SM1) | (1<<SM2))
+
+#define set_sleep_mode(mode)			(MCUCR = (MCUCR & ~((1<<SM0) | (1<<SM1) | (1<<SM2))) | (mode))
+#define sleep_enable()					(MCUCR |= (1<<SE))
+#define sleep_disable()					(MCUCR &= ~(1<<SE))
+
+/* The simulated time jumps to the interrupt which wakes up the CPU */
+#define sleep_cpu()						Sim_sleep()
+#define sleep_mode()					do { sleep_enable(); sleep_cpu(); sleep_disable(); } while(0)
+
+
+#endif /* SIM_AVR_SLEEP_H_ */
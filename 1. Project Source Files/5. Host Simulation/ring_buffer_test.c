@@ -0,0 +1,367 @@
+/*
+ ============================================================================
+ Name        : ring_buffer_test.c
+ Author      : Ahmed Shawky
+ Description : Host stress test of the ring buffer, a producer thread and a consumer thread
+ 	 	 	   take the roles of the ISR and the main loop
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include "ring_buffer.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The ring buffer publishes by the order of its volatile accesses only, like on AVR.
+ * x86 keeps the order of the stores and the order of the loads, other hosts need fences the library does not have. */
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "The ring buffer stress test needs the x86 memory ordering"
+#endif
+
+#define TEST_ELEMENTS					2000000UL
+#define TEST_SMALL_SIZE					16
+#define TEST_MEDIUM_SIZE				64
+#define TEST_LARGE_SIZE					128
+#define TEST_MAX_BULK					(TEST_LARGE_SIZE + 8)
+
+/* The producer and the consumer pick their calls from these modes */
+#define TEST_SINGLE						0x01
+#define TEST_BULK						0x02
+#define TEST_OVERWRITE					0x04
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+
+/* The complement catches an element read while the producer writes it */
+typedef struct
+{
+	uint32_t sequence ;
+	uint32_t check ;
+}Test_ElementType;
+
+typedef struct
+{
+	const char *name ;
+	uint8_t size ;
+	uint8_t producer_modes ;
+	uint8_t consumer_modes ;
+}Test_CaseType;
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static const Test_CaseType g_test_cases[] =
+{
+	{"push/pop",                   TEST_SMALL_SIZE,   TEST_SINGLE,              TEST_SINGLE},
+	{"pushBulk/popBulk",           TEST_SMALL_SIZE,   TEST_BULK,                TEST_BULK},
+	{"push+pushBulk/pop+popBulk",  TEST_LARGE_SIZE,   TEST_SINGLE | TEST_BULK,  TEST_SINGLE | TEST_BULK},
+	{"pushOverwrite/pop",          TEST_SMALL_SIZE,   TEST_OVERWRITE,           TEST_SINGLE},
+	{"pushOverwrite/popBulk",      TEST_SMALL_SIZE,   TEST_OVERWRITE,           TEST_BULK},
+	{"pushOverwrite/pop+popBulk",  TEST_MEDIUM_SIZE,  TEST_OVERWRITE,           TEST_SINGLE | TEST_BULK},
+};
+
+static Test_ElementType g_test_storage[TEST_LARGE_SIZE] ;
+static RingBuffer_Type g_test_ring ;
+static const Test_CaseType *g_test_case ;
+
+/* Incremented by the consumer after each pop call, the overwrite producer waits for it
+ * so it never pushes more than (256 - size) elements between two pops */
+static volatile uint32_t g_test_consumerCalls ;
+static volatile int g_test_producerDone ;
+static int g_test_failures = 0 ;
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Small generator, each thread has its own state so the runs do not share it */
+static uint32_t Test_random(uint32_t *state)
+{
+	*state = (*state * 1103515245UL) + 12345UL ;
+	return (*state >> 16) & 0x7FFF ;
+}
+
+static void Test_fail(const char *message, uint32_t expected, uint32_t value)
+{
+	printf("    %s: expected %lu, got %lu\n", message, (unsigned long)expected, (unsigned long)value);
+	g_test_failures++ ;
+}
+
+/* A side which can not move gives the CPU to the other one, on a single core host it would spin for its whole time slice */
+static void Test_waitIfIdle(uint8_t count)
+{
+	if(0 == count)
+	{
+		sched_yield();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+static void Test_fill(Test_ElementType *element, uint32_t sequence)
+{
+	element->sequence = sequence ;
+	element->check = ~sequence ;
+}
+
+/* Inputs: arg: unused.
+ *
+ * Return Value: NULL.
+ *
+ * Description:
+ * 	Producer thread, it pushes TEST_ELEMENTS numbered elements with the calls of the test case.
+ */
+static void *Test_producer(void *arg)
+{
+	Test_ElementType elements[TEST_MAX_BULK] ;
+	uint32_t state = 1 ;
+	uint32_t sequence = 0 ;
+	uint32_t pushes = 0 ;
+	uint32_t consumer_calls = g_test_consumerCalls ;
+	uint8_t count ;
+	uint8_t index ;
+
+	(void)arg ;
+	while(sequence < TEST_ELEMENTS)
+	{
+		if(g_test_case->producer_modes & TEST_OVERWRITE)
+		{
+			/* The documented limit, the consumer pops at least once every (256 - size) pushes */
+			if(pushes >= (256U - g_test_case->size))
+			{
+				while(consumer_calls == g_test_consumerCalls)
+				{
+					sched_yield();
+				}
+				consumer_calls = g_test_consumerCalls ;
+				pushes = 0 ;
+			}
+			Test_fill(&elements[0], sequence);
+			RingBuffer_pushOverwrite(&g_test_ring, &elements[0]);
+			sequence++ ;
+			pushes++ ;
+		}
+		else if((g_test_case->producer_modes & TEST_BULK) && (!(g_test_case->producer_modes & TEST_SINGLE) || (Test_random(&state) & 0x01)))
+		{
+			count = 1 + (Test_random(&state) % TEST_MAX_BULK) ;
+			count = ((TEST_ELEMENTS - sequence) < count) ? (uint8_t)(TEST_ELEMENTS - sequence) : count ;
+			for(index = 0 ; index < count ; index++)
+			{
+				Test_fill(&elements[index], sequence + index);
+			}
+			count = RingBuffer_pushBulk(&g_test_ring, elements, count) ;
+			sequence += count ;
+			Test_waitIfIdle(count);
+		}
+		else
+		{
+			Test_fill(&elements[0], sequence);
+			count = RingBuffer_push(&g_test_ring, &elements[0]) ? 1 : 0 ;
+			sequence += count ;
+			Test_waitIfIdle(count);
+		}
+	}
+	g_test_producerDone = 1 ;
+
+	return NULL ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: Number of the elements skipped after an overwrite.
+ *
+ * Description:
+ * 	Consumer loop, it pops until the producer is done and the buffer is empty, then checks that
+ * 	every element is whole and the sequence numbers increase. Without overwrite no element may be missing,
+ * 	with overwrite the newest element must be read.
+ */
+static uint32_t Test_consumer(void)
+{
+	Test_ElementType elements[TEST_MAX_BULK] ;
+	uint32_t state = 2 ;
+	uint32_t expected = 0 ;
+	uint32_t skipped = 0 ;
+	uint8_t count ;
+	uint8_t index ;
+	int failures = g_test_failures ;
+	int done ;
+
+	do
+	{
+		/* Read the flag before the pop, so the last pop sees every element */
+		done = g_test_producerDone ;
+
+		if((g_test_case->consumer_modes & TEST_BULK) && (!(g_test_case->consumer_modes & TEST_SINGLE) || (Test_random(&state) & 0x01)))
+		{
+			count = RingBuffer_popBulk(&g_test_ring, elements, 1 + (Test_random(&state) % TEST_MAX_BULK)) ;
+		}
+		else
+		{
+			count = RingBuffer_pop(&g_test_ring, &elements[0]) ? 1 : 0 ;
+		}
+		g_test_consumerCalls++ ;
+		Test_waitIfIdle(count);
+
+		for(index = 0 ; (index < count) && (failures == g_test_failures) ; index++)
+		{
+			if(elements[index].check != (uint32_t)~elements[index].sequence)
+			{
+				Test_fail("torn element", elements[index].sequence, ~elements[index].check);
+			}
+			else if(elements[index].sequence == expected)
+			{
+				expected++ ;
+			}
+			else if((g_test_case->producer_modes & TEST_OVERWRITE) && (elements[index].sequence > expected))
+			{
+				skipped += elements[index].sequence - expected ;
+				expected = elements[index].sequence + 1 ;
+			}
+			else
+			{
+				Test_fail("wrong sequence", expected, elements[index].sequence);
+			}
+		}
+	}while((failures == g_test_failures) && (!done || (count != 0))) ;
+
+	if((failures == g_test_failures) && (expected != TEST_ELEMENTS))
+	{
+		Test_fail("last element", TEST_ELEMENTS - 1, expected - 1);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return skipped ;
+}
+
+/* Inputs: test_case: the calls and the buffer size.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for run one producer thread against the consumer in the main thread.
+ */
+static void Test_runConcurrent(const Test_CaseType *test_case)
+{
+	pthread_t producer ;
+	uint32_t skipped ;
+	int failures = g_test_failures ;
+
+	g_test_case = test_case ;
+	g_test_producerDone = 0 ;
+	g_test_consumerCalls = 0 ;
+	RingBuffer_init(&g_test_ring, g_test_storage, sizeof(Test_ElementType), test_case->size);
+
+	if(0 != pthread_create(&producer, NULL, Test_producer, NULL))
+	{
+		printf("Cannot create the producer thread\n");
+		exit(EXIT_FAILURE);
+	}
+	skipped = Test_consumer() ;
+
+	/* A failed consumer stops early and the producer may wait for it forever, so the test ends here */
+	if(g_test_failures == failures)
+	{
+		pthread_join(producer, NULL);
+		printf("PASS %s (size %u, %lu skipped)\n", test_case->name, test_case->size, (unsigned long)skipped);
+	}
+	else
+	{
+		printf("FAIL %s (size %u)\n", test_case->name, test_case->size);
+		exit(EXIT_FAILURE);
+	}
+}
+
+/* Inputs: size: buffer size.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Single thread check of RingBuffer_pushOverwrite at the documented limit: the buffer holds (size - 1) unread
+ * 	elements, then (256 - size) more are pushed without a pop, the newest (size - 1) elements must be read in order.
+ */
+static void Test_runWrapLimit(uint8_t size)
+{
+	Test_ElementType element ;
+	uint32_t sequence ;
+	uint32_t pushed = 0 ;
+	int failures = g_test_failures ;
+
+	RingBuffer_init(&g_test_ring, g_test_storage, sizeof(Test_ElementType), size);
+
+	/* Move the indexes near the 8-bit wrap first */
+	for(sequence = 0 ; sequence < 250 ; sequence++)
+	{
+		Test_fill(&element, sequence);
+		RingBuffer_push(&g_test_ring, &element);
+		RingBuffer_pop(&g_test_ring, &element);
+	}
+
+	for(sequence = 0 ; sequence < (uint32_t)(size - 1) ; sequence++)
+	{
+		Test_fill(&element, pushed++);
+		RingBuffer_push(&g_test_ring, &element);
+	}
+	for(sequence = 0 ; sequence < (uint32_t)(256 - size) ; sequence++)
+	{
+		Test_fill(&element, pushed++);
+		RingBuffer_pushOverwrite(&g_test_ring, &element);
+	}
+
+	if(RingBuffer_getCount(&g_test_ring) != (uint8_t)(size - 1))
+	{
+		Test_fail("count at the wrap limit", size - 1, RingBuffer_getCount(&g_test_ring));
+	}
+	for(sequence = pushed - (size - 1) ; (sequence < pushed) && (g_test_failures == failures) ; sequence++)
+	{
+		if(!RingBuffer_pop(&g_test_ring, &element) || (element.sequence != sequence))
+		{
+			Test_fail("element at the wrap limit", sequence, element.sequence);
+		}
+	}
+	if(RingBuffer_pop(&g_test_ring, &element))
+	{
+		Test_fail("element after the newest one", pushed - 1, element.sequence);
+	}
+
+	/* The next push after the drain is read alone */
+	Test_fill(&element, pushed);
+	RingBuffer_pushOverwrite(&g_test_ring, &element);
+	if(!RingBuffer_pop(&g_test_ring, &element) || (element.sequence != pushed))
+	{
+		Test_fail("element after the drain", pushed, element.sequence);
+	}
+	printf("%s pushOverwrite wrap limit (size %u)\n", (g_test_failures == failures) ? "PASS" : "FAIL", size);
+}
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+int main(void)
+{
+	uint8_t index ;
+
+	Test_runWrapLimit(TEST_SMALL_SIZE);
+	Test_runWrapLimit(TEST_LARGE_SIZE);
+	for(index = 0 ; index < (sizeof(g_test_cases) / sizeof(g_test_cases[0])) ; index++)
+	{
+		Test_runConcurrent(&g_test_cases[index]);
+	}
+
+	return (0 == g_test_failures) ? EXIT_SUCCESS : EXIT_FAILURE ;
+}
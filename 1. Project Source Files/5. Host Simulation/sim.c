@@ -0,0 +1,1953 @@
+/*
+ ============================================================================
+ Name        : sim.c
+ Author      : Ahmed Shawky
+ Description : Source File for the Host Simulation of the ATmega32 registers
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <avr/io.h>
+#include "std_types.h"
+#include "lcd.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define SIM_IO_SIZE						64
+#define SIM_NO_EVENT					((uint64)-1)
+
+/* Register accesses kept open, so a write through a pointer returned before another access is still seen */
+#define SIM_OPEN_ACCESSES				4
+
+#define SIM_MAIN_CONTEXT				0
+#define SIM_ISR_CONTEXT					1
+
+/* I/O address of PORTx, DDRx and PINx registers for the GPIO port id */
+#define SIM_PORT_ADDRESS(port_num)		(0x1B - (3 * (port_num)))
+#define SIM_DDR_ADDRESS(port_num)		(SIM_PORT_ADDRESS(port_num) - 1)
+#define SIM_PIN_ADDRESS(port_num)		(SIM_PORT_ADDRESS(port_num) - 2)
+
+#define SIM_IO(address)					(g_sim_io.byte[(address)])
+
+#define SIM_US_TO_CYCLES(us)			((uint64)(us) * (F_CPU / 1000000UL))
+
+/* EECR bit 4 is not used by the hardware, the simulator keeps the EEPROM ready state of EE_RDY in it */
+#define SIM_EECR_READY					4
+
+/* EEWE should be set within 4 cycles after EEMWE */
+#define SIM_EEPROM_MASTER_CYCLES		4
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef struct
+{
+	uint8 address ;
+	uint8 width ;			/* 0 for a free slot, 1 or 2 bytes */
+	uint8 checked ;			/* read side effects are applied only once */
+	uint16 snapshot ;		/* register value given to the firmware */
+	union
+	{
+		uint8 byte ;
+		uint16 word ;
+	}stage;
+}Sim_AccessType;
+
+typedef struct
+{
+	uint64 start_cycle ;
+	uint32 start_count ;
+	uint32 modulus ;
+	uint16 prescaler ;		/* 0 when the timer is stopped */
+}Sim_TimerType;
+
+typedef struct
+{
+	void (*handler)(void);
+	uint8 flag_address ;
+	uint8 flag_bit ;
+	uint8 enable_address ;
+	uint8 enable_bit ;
+	boolean auto_clear ;	/* FALSE when the flag is cleared only by the peripheral, as USART RXC and UDRE */
+}Sim_InterruptType;
+
+/****************************************************************************
+ * 						 Interrupt Vectors of ATmega32					    *
+ ****************************************************************************/
+
+/* Only the vectors defined by the firmware are linked, the others stay NULL */
+void TIMER1_CAPT_vect(void) __attribute__((weak));
+void TIMER1_COMPA_vect(void) __attribute__((weak));
+void TIMER1_COMPB_vect(void) __attribute__((weak));
+void TIMER1_OVF_vect(void) __attribute__((weak));
+void TIMER0_COMP_vect(void) __attribute__((weak));
+void TIMER0_OVF_vect(void) __attribute__((weak));
+void USART_RXC_vect(void) __attribute__((weak));
+void USART_UDRE_vect(void) __attribute__((weak));
+void USART_TXC_vect(void) __attribute__((weak));
+void ADC_vect(void) __attribute__((weak));
+void EE_RDY_vect(void) __attribute__((weak));
+
+/* Ordered by the vector number, the lower vector has the higher priority */
+static const Sim_InterruptType g_sim_interrupts[] =
+{
+	{TIMER1_CAPT_vect,  0x38, ICF1,           0x39, TICIE1, TRUE},
+	{TIMER1_COMPA_vect, 0x38, OCF1A,          0x39, OCIE1A, TRUE},
+	{TIMER1_COMPB_vect, 0x38, OCF1B,          0x39, OCIE1B, TRUE},
+	{TIMER1_OVF_vect,   0x38, TOV1,           0x39, TOIE1,  TRUE},
+	{TIMER0_COMP_vect,  0x38, OCF0,           0x39, OCIE0,  TRUE},
+	{TIMER0_OVF_vect,   0x38, TOV0,           0x39, TOIE0,  TRUE},
+	{USART_RXC_vect,    0x0B, RXC,            0x0A, RXCIE,  FALSE},
+	{USART_UDRE_vect,   0x0B, UDRE,           0x0A, UDRIE,  FALSE},
+	{USART_TXC_vect,    0x0B, TXC,            0x0A, TXCIE,  TRUE},
+	{ADC_vect,          0x06, ADIF,           0x06, ADIE,   TRUE},
+	{EE_RDY_vect,       0x1C, SIM_EECR_READY, 0x1C, EERIE,  FALSE},
+};
+
+#define SIM_NUM_OF_INTERRUPTS			(sizeof(g_sim_interrupts) / sizeof(g_sim_interrupts[0]))
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static union
+{
+	uint8 byte[SIM_IO_SIZE] ;
+	uint16 word[SIM_IO_SIZE / 2] ;
+}g_sim_io;
+
+static Sim_AccessType g_sim_access[2][SIM_OPEN_ACCESSES] ;
+static uint8 g_sim_accessNext[2] ;
+static uint8 g_sim_context = SIM_MAIN_CONTEXT ;
+
+static uint64 g_sim_cycleLimit = SIM_NO_EVENT ;
+static uint64 g_sim_nextEvent = SIM_NO_EVENT ;
+static Sim_StatisticsType g_sim_statistics ;
+static struct timespec g_sim_startTime ;
+
+/* External signals driven on the input pins of each port */
+static uint8 g_sim_pinDriveMask[NUM_OF_PORTS] ;
+static uint8 g_sim_pinDriveValue[NUM_OF_PORTS] ;
+
+/* Timer0 */
+static Sim_TimerType g_sim_timer0 = {0, 0, 256, 0} ;
+static uint64 g_sim_timer0OverflowEvent = SIM_NO_EVENT ;
+static uint64 g_sim_timer0CompareEvent = SIM_NO_EVENT ;
+
+/* Timer1 */
+static Sim_TimerType g_sim_timer1 = {0, 0, 65536, 0} ;
+static uint64 g_sim_timer1OverflowEvent = SIM_NO_EVENT ;
+static uint64 g_sim_timer1CompareAEvent = SIM_NO_EVENT ;
+static uint64 g_sim_timer1CompareBEvent = SIM_NO_EVENT ;
+
+/* Tach edges on ICP1 pin */
+static uint64 g_sim_icpEvent = SIM_NO_EVENT ;
+static boolean g_sim_icpEdge = FALSE ;			/* FALSE when the event only asks the model again */
+
+/* ADC */
+static uint64 g_sim_uartEvent = SIM_NO_EVENT ;	/* end of the frame in the transmit shift register */
+static uint8 g_sim_uartControlC = (1<<UCSZ1) | (1<<UCSZ0) ;	/* UCSRC shares its address with UBRRH */
+static boolean g_sim_uartShiftFull = FALSE ;
+static uint8 g_sim_uartShift = 0 ;
+static boolean g_sim_uartBufferFull = FALSE ;
+static uint8 g_sim_uartBuffer = 0 ;
+static int g_sim_uartOutputFd = -1 ;
+
+static uint64 g_sim_adcEvent = SIM_NO_EVENT ;
+static uint8 g_sim_adcMux = 0 ;
+static boolean g_sim_adcFirstConversion = TRUE ;
+static uint16 g_sim_adcInputMillivolts[8] ;
+static uint16 g_sim_adcNoiseMillivolts = 0 ;
+static uint16 g_sim_adcSpikeMillivolts = 0 ;
+static uint32 g_sim_adcNoiseSeed = 1 ;
+static uint16 g_sim_internalReferenceMillivolts = 2560 ;
+
+/* EEPROM content and the byte written through the registers */
+static uint8 g_sim_eeprom[SIM_EEPROM_SIZE] ;
+static uint64 g_sim_eepromEvent = SIM_NO_EVENT ;	/* end of the running write */
+static uint64 g_sim_eepromMasterEnd = 0 ;		/* last cycle EEWE can be set after EEMWE */
+static uint16 g_sim_eepromWriteAddress = 0 ;
+static uint8 g_sim_eepromWriteData = 0 ;
+
+/* PWM outputs of OC0 and OC2 */
+static uint16 g_sim_pwmDuty[SIM_NUM_OF_PWM_OUTPUTS] ;
+static uint64 g_sim_pwmDutyCycles[SIM_NUM_OF_PWM_OUTPUTS] ;
+static uint64 g_sim_pwmLastCycle[SIM_NUM_OF_PWM_OUTPUTS] ;
+
+/* LCD bus and HD44780 controller */
+static uint8 g_sim_lcdEnable = LOGIC_LOW ;
+static boolean g_sim_lcdEightBitsInterface = TRUE ;
+#if(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+static boolean g_sim_lcdSecondNibble = FALSE ;
+static uint8 g_sim_lcdHighNibble = 0 ;
+#endif
+static uint64 g_sim_lcdBusyUntil = 0 ;
+static uint8 g_sim_lcdDdram[0x80] ;
+static uint8 g_sim_lcdAddress = 0 ;
+static boolean g_sim_lcdCgramSelected = FALSE ;
+static char g_sim_lcdRowText[LCD_COLS + 1] ;
+
+/****************************************************************************
+ * 						Private Functions Prototypes					    *
+ ****************************************************************************/
+static uint16 Sim_defaultAdcModel(uint8_t mux, uint16_t reference_mv);
+static sint32 Sim_adcPinMicrovolts(uint8 pin);
+static void Sim_defaultPwmModel(uint8_t output, uint16_t duty, uint64_t cycle);
+static uint16 Sim_defaultLcdModel(uint8_t rs, uint8_t data);
+static uint32_t Sim_defaultTachModel(uint64_t cycle);
+static void Sim_defaultUartModel(uint8_t data, uint64_t cycle);
+
+static Sim_AdcModelType g_sim_adcModel = Sim_defaultAdcModel ;
+static Sim_PwmModelType g_sim_pwmModel = Sim_defaultPwmModel ;
+static Sim_LcdModelType g_sim_lcdModel = Sim_defaultLcdModel ;
+static Sim_TachModelType g_sim_tachModel = Sim_defaultTachModel ;
+static Sim_UartModelType g_sim_uartModel = Sim_defaultUartModel ;
+static Sim_FinishHookType g_sim_finishHook = NULL_PTR ;
+
+static Sim_AccessType *Sim_openAccess(uint8 address, uint8 width);
+static void Sim_commitAccesses(void);
+static uint16 Sim_readRegister(uint8 address, uint8 width);
+static void Sim_writeRegister(uint8 address, uint8 width, uint16 value);
+static void Sim_readSideEffects(uint8 address, uint8 value);
+static void Sim_advance(uint64 cycles);
+static void Sim_processEvents(void);
+static void Sim_updateNextEvent(void);
+static void Sim_serveInterrupts(void);
+
+static uint16 Sim_clockSelectToPrescaler(uint8 clock_select);
+static uint32 Sim_timerCount(const Sim_TimerType *timer);
+static void Sim_timerSetCount(Sim_TimerType *timer, uint32 count);
+static void Sim_timerSetPrescaler(Sim_TimerType *timer, uint16 prescaler);
+static uint64 Sim_timerNextMatch(const Sim_TimerType *timer, uint32 value);
+static void Sim_timer0Reschedule(void);
+static void Sim_timer1Reschedule(void);
+
+static void Sim_adcStartConversion(void);
+static void Sim_adcTriggerEvent(uint8 source, uint8 flag);
+static void Sim_adcCompleteConversion(void);
+static void Sim_icpSchedule(void);
+static void Sim_icpCapture(void);
+static void Sim_uartWriteData(uint8 data);
+static void Sim_uartStartFrame(void);
+static void Sim_uartCompleteFrame(void);
+static void Sim_eepromControlWrite(uint8 old, uint8 value);
+static void Sim_eepromCompleteWrite(void);
+static uint16 Sim_pwmOutputDuty(uint8 tccr, uint8 compare, boolean pin_high);
+static void Sim_pwmUpdate(void);
+static uint8 Sim_portOutput(uint8 port_num);
+static void Sim_lcdBusUpdate(void);
+static void Sim_lcdLatch(uint8 rs, uint8 data);
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Inputs: address: I/O address of the register.
+ *
+ * Return Value: Pointer to a copy of the register value.
+ *
+ * Description:
+ * 	Function responsible for give the firmware an 8-bit register.
+ * 	The simulated time moves forward and the interrupts are served before the register is read,
+ * 	the value written through the pointer is applied on the next access.
+ */
+volatile uint8_t *Sim_accessRegister(uint8_t address)
+{
+	Sim_AccessType *access = Sim_openAccess(address, 1) ;
+
+	return &access->stage.byte ;
+}
+
+/* Inputs: address: I/O address of the low byte of the register.
+ *
+ * Return Value: Pointer to a copy of the register value.
+ *
+ * Description:
+ * 	Function responsible for give the firmware a 16-bit register, the same as Sim_accessRegister.
+ */
+volatile uint16_t *Sim_accessRegister16(uint8_t address)
+{
+	Sim_AccessType *access = Sim_openAccess(address, 2) ;
+
+	return &access->stage.word ;
+}
+
+/* Inputs: cycles: number of CPU cycles.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for move the simulated time forward while serving the interrupts,
+ * 	it replaces the busy loops of <util/delay.h>.
+ */
+void Sim_delayCycles(uint64_t cycles)
+{
+	uint64 target = g_sim_statistics.cycles + cycles ;
+	uint64 stop ;
+
+	Sim_commitAccesses();
+
+	while(g_sim_statistics.cycles < target)
+	{
+		/* Jump directly to the next peripheral event */
+		stop = (g_sim_nextEvent < target) ? g_sim_nextEvent : target ;
+		if(stop <= g_sim_statistics.cycles)
+		{
+			stop = g_sim_statistics.cycles + 1 ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+		Sim_advance(stop - g_sim_statistics.cycles);
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for execute the sleep instruction, when SE bit is set the simulated time
+ * 	jumps from event to event until an interrupt is served.
+ * 	Sleeping with the interrupts disabled never wakes up, the simulation ends at its time limit.
+ */
+void Sim_sleep(void)
+{
+	uint64 interrupts = g_sim_statistics.interrupts ;
+	uint64 start = g_sim_statistics.cycles ;
+
+	/* The instruction after sei is executed first, an interrupt which is already pending wakes up the CPU directly */
+	Sim_commitAccesses();
+	Sim_serveInterrupts();
+
+	if(SIM_IO(0x35) & (1<<SE))
+	{
+		while(interrupts == g_sim_statistics.interrupts)
+		{
+			Sim_advance((g_sim_nextEvent > g_sim_statistics.cycles) ? (g_sim_nextEvent - g_sim_statistics.cycles) : 1);
+		}
+		g_sim_statistics.sleep_cycles += g_sim_statistics.cycles - start ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+/* Inputs: cycle_limit: number of CPU cycles to simulate.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for reset the registers and the peripherals models.
+ */
+void Sim_init(uint64_t cycle_limit)
+{
+	memset(&g_sim_io, 0, sizeof(g_sim_io));
+	memset(g_sim_access, 0, sizeof(g_sim_access));
+	memset(&g_sim_statistics, 0, sizeof(g_sim_statistics));
+	memset(g_sim_lcdDdram, ' ', sizeof(g_sim_lcdDdram));
+	memset(g_sim_eeprom, 0xFF, sizeof(g_sim_eeprom));
+
+	/* USART data register is empty after reset */
+	SIM_IO(0x0B) = (1<<UDRE) ;
+
+	/* No EEPROM write is running */
+	SIM_IO(0x1C) = (1<<SIM_EECR_READY) ;
+	g_sim_eepromEvent = SIM_NO_EVENT ;
+
+	g_sim_cycleLimit = cycle_limit ;
+	Sim_icpSchedule();
+	clock_gettime(CLOCK_MONOTONIC, &g_sim_startTime);
+}
+
+void Sim_setAdcModel(Sim_AdcModelType model)
+{
+	g_sim_adcModel = (model != NULL_PTR) ? model : Sim_defaultAdcModel ;
+}
+
+void Sim_setPwmModel(Sim_PwmModelType model)
+{
+	g_sim_pwmModel = (model != NULL_PTR) ? model : Sim_defaultPwmModel ;
+}
+
+void Sim_setLcdModel(Sim_LcdModelType model)
+{
+	g_sim_lcdModel = (model != NULL_PTR) ? model : Sim_defaultLcdModel ;
+}
+
+void Sim_setTachModel(Sim_TachModelType model)
+{
+	g_sim_tachModel = (model != NULL_PTR) ? model : Sim_defaultTachModel ;
+	Sim_icpSchedule();
+}
+
+void Sim_setUartModel(Sim_UartModelType model)
+{
+	g_sim_uartModel = (model != NULL_PTR) ? model : Sim_defaultUartModel ;
+}
+
+void Sim_setFinishHook(Sim_FinishHookType hook)
+{
+	g_sim_finishHook = hook ;
+}
+
+void Sim_setUartOutput(int fd)
+{
+	g_sim_uartOutputFd = fd ;
+}
+
+/* Inputs:
+ * 	1. channel   : ADC0..ADC7 pin.
+ * 	2. millivolts: voltage applied on the pin.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for set the input of the default ADC model.
+ */
+void Sim_setAdcInputMillivolts(uint8_t channel, uint16_t millivolts)
+{
+	g_sim_adcInputMillivolts[channel & 0x07] = millivolts ;
+}
+
+/* Inputs:
+ * 	1. peak_millivolts: the noise is uniform between -peak and +peak.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for add noise to the inputs of the default ADC model.
+ */
+void Sim_setAdcNoiseMillivolts(uint16_t peak_millivolts)
+{
+	g_sim_adcNoiseMillivolts = peak_millivolts ;
+}
+
+/* Inputs:
+ * 	1. spike_millivolts: voltage added to one conversion in SIM_ADC_SPIKE_PERIOD on average.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for add random spikes to the inputs of the default ADC model, as the switching noise.
+ */
+void Sim_setAdcSpikeMillivolts(uint16_t spike_millivolts)
+{
+	g_sim_adcSpikeMillivolts = spike_millivolts ;
+}
+
+/* Inputs:
+ * 	1. millivolts: the real voltage of the internal reference.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for simulate a part with a reference error, the datasheet allows 2.3V to 2.7V.
+ */
+void Sim_setInternalReferenceMillivolts(uint16_t millivolts)
+{
+	g_sim_internalReferenceMillivolts = millivolts ;
+}
+
+uint8_t Sim_eepromReadByte(uint16_t address)
+{
+	return g_sim_eeprom[address % SIM_EEPROM_SIZE] ;
+}
+
+uint16_t Sim_eepromReadWord(uint16_t address)
+{
+	return (uint16)(Sim_eepromReadByte(address) | (Sim_eepromReadByte(address + 1) << 8)) ;
+}
+
+/* Inputs:
+ * 	1. address: EEPROM byte address.
+ * 	2. value  : the new byte value.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for write one EEPROM byte if it changes, the CPU waits for the end of the write
+ * 	as avr-libc does, the interrupts are still served during it.
+ */
+void Sim_eepromUpdateByte(uint16_t address, uint8_t value)
+{
+	if(g_sim_eeprom[address % SIM_EEPROM_SIZE] != value)
+	{
+		g_sim_eeprom[address % SIM_EEPROM_SIZE] = value ;
+		g_sim_statistics.eeprom_writes++ ;
+		Sim_delayCycles(SIM_US_TO_CYCLES(SIM_EEPROM_WRITE_US));
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+void Sim_eepromUpdateWord(uint16_t address, uint16_t value)
+{
+	Sim_eepromUpdateByte(address, (uint8)value);
+	Sim_eepromUpdateByte(address + 1, (uint8)(value >> 8));
+}
+
+uint8_t *Sim_getEeprom(void)
+{
+	return g_sim_eeprom ;
+}
+
+uint16_t Sim_getPwmDuty(uint8_t output)
+{
+	return g_sim_pwmDuty[output % SIM_NUM_OF_PWM_OUTPUTS] ;
+}
+
+/* Inputs: output: SIM_PWM_OC0 or SIM_PWM_OC2.
+ *
+ * Return Value: Average duty of the output in percent from the start of the simulation.
+ *
+ * Description:
+ * 	Function responsible for return the time weighted average of the default PWM model.
+ */
+double Sim_getPwmAverageDuty(uint8_t output)
+{
+	uint64 now = g_sim_statistics.cycles ;
+	double average = 0 ;
+
+	output %= SIM_NUM_OF_PWM_OUTPUTS ;
+	if(now > 0)
+	{
+		average = (g_sim_pwmDutyCycles[output] + (double)g_sim_pwmDuty[output] * (now - g_sim_pwmLastCycle[output]))
+				  * 100.0 / (256.0 * now) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return average ;
+}
+
+/* Inputs: row: LCD row number.
+ *
+ * Return Value: The characters shown on the row.
+ *
+ * Description:
+ * 	Function responsible for read the display data RAM of the default LCD model.
+ */
+const char *Sim_getLcdRow(uint8_t row)
+{
+	static const uint8 row_address[4] = {0x00, 0x40, 0x10, 0x50} ;
+	uint8 col ;
+
+	for(col = 0 ; col < LCD_COLS ; col++)
+	{
+		g_sim_lcdRowText[col] = (char)g_sim_lcdDdram[row_address[row & 0x03] + col] ;
+	}
+	g_sim_lcdRowText[LCD_COLS] = '\0' ;
+
+	return g_sim_lcdRowText ;
+}
+
+const Sim_StatisticsType *Sim_getStatistics(void)
+{
+	return &g_sim_statistics ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for print the simulation report then exit,
+ * 	the exit status is ZERO or the value returned by the finish hook.
+ */
+void Sim_finish(void)
+{
+	struct timespec end_time ;
+	double host_seconds ;
+	double mcu_seconds = (double)g_sim_statistics.cycles / F_CPU ;
+	uint8 row ;
+
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+	host_seconds = (end_time.tv_sec - g_sim_startTime.tv_sec) + (end_time.tv_nsec - g_sim_startTime.tv_nsec) / 1e9 ;
+	if(host_seconds <= 0)
+	{
+		host_seconds = 1e-9 ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	printf("Simulated time    : %.3f s (%llu cycles)\n", mcu_seconds, (unsigned long long)g_sim_statistics.cycles);
+	printf("Host time         : %.3f s (%.1f x real time)\n", host_seconds, mcu_seconds / host_seconds);
+	printf("Register accesses : %llu (%.1f M/s)\n", (unsigned long long)g_sim_statistics.register_accesses,
+			g_sim_statistics.register_accesses / host_seconds / 1e6);
+	printf("Interrupts        : %llu\n", (unsigned long long)g_sim_statistics.interrupts);
+	printf("CPU sleeping      : %.1f %%\n", (g_sim_statistics.cycles != 0) ?
+			(g_sim_statistics.sleep_cycles * 100.0 / g_sim_statistics.cycles) : 0.0);
+	printf("ADC conversions   : %llu\n", (unsigned long long)g_sim_statistics.adc_conversions);
+	printf("PWM updates       : %llu (OC0 duty %u/256, average %.1f %%, OC2 duty %u/256, average %.1f %%)\n",
+			(unsigned long long)g_sim_statistics.pwm_updates, g_sim_pwmDuty[SIM_PWM_OC0], Sim_getPwmAverageDuty(SIM_PWM_OC0),
+			g_sim_pwmDuty[SIM_PWM_OC2], Sim_getPwmAverageDuty(SIM_PWM_OC2));
+	printf("LCD bytes         : %llu\n", (unsigned long long)g_sim_statistics.lcd_bytes);
+	printf("Tach edges        : %llu\n", (unsigned long long)g_sim_statistics.tach_edges);
+	printf("UART bytes        : %llu\n", (unsigned long long)g_sim_statistics.uart_bytes);
+	printf("EEPROM writes     : %llu\n", (unsigned long long)g_sim_statistics.eeprom_writes);
+	for(row = 0 ; row < LCD_ROWS ; row++)
+	{
+		printf("LCD row %u         : \"%s\"\n", row, Sim_getLcdRow(row));
+	}
+
+	fflush(stdout);
+	exit((g_sim_finishHook != NULL_PTR) ? g_sim_finishHook() : 0);
+}
+
+/* Inputs:
+ * 	1. value: integer number.
+ * 	2. str  : output buffer.
+ * 	3. radix: number base from 2 to 36.
+ *
+ * Return Value: The output buffer.
+ *
+ * Description:
+ * 	Function responsible for convert the integer to string the same as avr-libc.
+ */
+char *itoa(int value, char *str, int radix)
+{
+	char digits[sizeof(int) * 8 + 1] ;
+	unsigned int number = (unsigned int)value ;
+	uint8 count = 0 ;
+	uint8 index = 0 ;
+
+	if((value < 0) && (10 == radix))
+	{
+		str[index++] = '-' ;
+		number = -(unsigned int)value ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	do
+	{
+		digits[count++] = "0123456789abcdefghijklmnopqrstuvwxyz"[number % radix] ;
+		number /= radix ;
+	}while(number != 0);
+
+	while(count > 0)
+	{
+		str[index++] = digits[--count] ;
+	}
+	str[index] = '\0' ;
+
+	return str ;
+}
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Inputs:
+ * 	1. address: I/O address of the register.
+ * 	2. width  : 1 or 2 bytes.
+ *
+ * Return Value: The access slot holding the register value.
+ *
+ * Description:
+ * 	Function responsible for apply the previous writes, move the time forward, serve the interrupts
+ * 	then copy the current register value to a new access slot.
+ */
+static Sim_AccessType *Sim_openAccess(uint8 address, uint8 width)
+{
+	uint8 context ;
+	Sim_AccessType *access ;
+
+	Sim_commitAccesses();
+	Sim_advance(SIM_CYCLES_PER_ACCESS);
+
+	context = g_sim_context ;
+	access = &g_sim_access[context][g_sim_accessNext[context]] ;
+	g_sim_accessNext[context] = (g_sim_accessNext[context] + 1) % SIM_OPEN_ACCESSES ;
+
+	access->address = address ;
+	access->width = width ;
+	access->checked = FALSE ;
+	access->snapshot = Sim_readRegister(address, width) ;
+	if(1 == width)
+	{
+		access->stage.byte = (uint8)access->snapshot ;
+	}
+	else
+	{
+		access->stage.word = access->snapshot ;
+	}
+	g_sim_statistics.register_accesses++ ;
+
+	return access ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for find the open slots changed by the firmware and write them to the registers.
+ * 	A slot with the same value is treated as a read.
+ */
+static void Sim_commitAccesses(void)
+{
+	uint8 context ;
+	uint8 slot ;
+	uint16 value ;
+	Sim_AccessType *access ;
+
+	for(context = SIM_MAIN_CONTEXT ; context <= SIM_ISR_CONTEXT ; context++)
+	{
+		for(slot = 0 ; slot < SIM_OPEN_ACCESSES ; slot++)
+		{
+			access = &g_sim_access[context][slot] ;
+			if(0 == access->width)
+			{
+				continue ;
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+
+			value = (1 == access->width) ? access->stage.byte : access->stage.word ;
+			if(value != access->snapshot)
+			{
+				access->snapshot = value ;
+				access->checked = TRUE ;
+				Sim_writeRegister(access->address, access->width, value);
+			}
+			else if(FALSE == access->checked)
+			{
+				access->checked = TRUE ;
+				if(1 == access->width)
+				{
+					Sim_readSideEffects(access->address, (uint8)value);
+				}
+				else
+				{
+					/* Do Nothing. */
+				}
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+		}
+	}
+}
+
+/* Inputs:
+ * 	1. address: I/O address of the register.
+ * 	2. width  : 1 or 2 bytes.
+ *
+ * Return Value: The register value seen by the firmware.
+ *
+ * Description:
+ * 	Function responsible for read the register, the counters and the input pins are calculated at the read time.
+ */
+static uint16 Sim_readRegister(uint8 address, uint8 width)
+{
+	uint8 port_num ;
+	uint8 port ;
+	uint8 ddr ;
+	uint16 value ;
+
+	switch(address)
+	{
+	case 0x19: case 0x16: case 0x13: case 0x10:
+		/* PINx: the output pins read back their value, the input pins read the external signal or the pull up */
+		port_num = (0x19 - address) / 3 ;
+		port = SIM_IO(address + 2) ;
+		ddr = SIM_IO(address + 1) ;
+		value = (port & ddr) | (~ddr & ((g_sim_pinDriveMask[port_num] & g_sim_pinDriveValue[port_num]) |
+										(~g_sim_pinDriveMask[port_num] & port))) ;
+		value &= 0xFF ;
+		break;
+	case 0x32:
+		value = (uint8)Sim_timerCount(&g_sim_timer0) ;
+		break;
+	case 0x2C:
+		value = (uint16)Sim_timerCount(&g_sim_timer1) ;
+		value = (2 == width) ? value : (value & 0xFF) ;
+		break;
+	case 0x2D:
+		value = (uint16)Sim_timerCount(&g_sim_timer1) >> 8 ;
+		break;
+	case 0x1C:
+		value = SIM_IO(address) & ~(1<<SIM_EECR_READY) ;
+		break;
+	default:
+		value = (2 == width) ? g_sim_io.word[address / 2] : SIM_IO(address) ;
+		break;
+	}
+
+	return value ;
+}
+
+/* Inputs:
+ * 	1. address: I/O address of the register.
+ * 	2. width  : 1 or 2 bytes.
+ * 	3. value  : value written by the firmware.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for write the register and inform the peripheral model of it.
+ */
+static void Sim_writeRegister(uint8 address, uint8 width, uint16 value)
+{
+	uint8 old = SIM_IO(address) ;
+
+	switch(address)
+	{
+	case 0x38:
+		/* TIFR: the flags are cleared by writing logic one */
+		SIM_IO(address) &= ~value ;
+		break;
+	case 0x06:
+		/* ADCSRA: ADIF is cleared by writing logic one and ADSC is cleared only by the ADC */
+		SIM_IO(address) = (value & ~((1<<ADIF) | (1<<ADSC))) | (old & (1<<ADSC)) | (old & ~value & (1<<ADIF)) ;
+		if(!(value & (1<<ADEN)))
+		{
+			/* Disabling the ADC aborts the running conversion */
+			SIM_IO(address) &= ~(1<<ADSC) ;
+			g_sim_adcEvent = SIM_NO_EVENT ;
+			g_sim_adcFirstConversion = TRUE ;
+		}
+		else if((value & (1<<ADSC)) && !(old & (1<<ADSC)))
+		{
+			Sim_adcStartConversion();
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+		break;
+	case 0x32:
+		Sim_timerSetCount(&g_sim_timer0, value & 0xFF);
+		Sim_timer0Reschedule();
+		break;
+	case 0x33:
+		SIM_IO(address) = value & ~(1<<FOC0) ;
+		Sim_timerSetPrescaler(&g_sim_timer0, Sim_clockSelectToPrescaler(value & 0x07));
+		Sim_timer0Reschedule();
+		Sim_pwmUpdate();
+		break;
+	case 0x3C:
+		SIM_IO(address) = value ;
+		Sim_timer0Reschedule();
+		Sim_pwmUpdate();
+		break;
+	case 0x25: case 0x23:
+		/* Timer2 is used only for the OC2 PWM output, its counter is not simulated */
+		SIM_IO(address) = (0x25 == address) ? (value & ~(1<<FOC2)) : value ;
+		Sim_pwmUpdate();
+		break;
+	case 0x2C: case 0x2D:
+		if(2 == width)
+		{
+			Sim_timerSetCount(&g_sim_timer1, value);
+		}
+		else if(0x2C == address)
+		{
+			Sim_timerSetCount(&g_sim_timer1, (Sim_timerCount(&g_sim_timer1) & 0xFF00) | (value & 0xFF));
+		}
+		else
+		{
+			Sim_timerSetCount(&g_sim_timer1, (Sim_timerCount(&g_sim_timer1) & 0x00FF) | ((value & 0xFF) << 8));
+		}
+		Sim_timer1Reschedule();
+		break;
+	case 0x2E:
+		SIM_IO(address) = value ;
+		Sim_timerSetPrescaler(&g_sim_timer1, Sim_clockSelectToPrescaler(value & 0x07));
+		Sim_timer1Reschedule();
+		break;
+	case 0x2A: case 0x2B: case 0x28: case 0x29:
+		if(2 == width)
+		{
+			g_sim_io.word[address / 2] = value ;
+		}
+		else
+		{
+			SIM_IO(address) = value ;
+		}
+		Sim_timer1Reschedule();
+		break;
+	case 0x0C:
+		Sim_uartWriteData((uint8)value);
+		break;
+	case 0x1C:
+		Sim_eepromControlWrite(old, (uint8)value);
+		break;
+	case 0x0B:
+		/* UCSRA: TXC is cleared by writing logic one, only U2X and MPCM are writable */
+		SIM_IO(address) = (old & ~((1<<U2X) | (1<<MPCM) | (1<<TXC))) | (value & ((1<<U2X) | (1<<MPCM))) |
+						  (old & ~value & (1<<TXC)) ;
+		break;
+	case 0x20:
+		/* URSEL selects UCSRC or UBRRH */
+		if(value & (1<<URSEL))
+		{
+			g_sim_uartControlC = (uint8)value ;
+		}
+		else
+		{
+			SIM_IO(address) = value & 0x0F ;
+		}
+		break;
+	case 0x19: case 0x16: case 0x13: case 0x10:
+		/* PINx registers are read only in ATmega32 */
+		break;
+	case 0x1B: case 0x1A: case 0x18: case 0x17: case 0x15: case 0x14: case 0x12: case 0x11:
+		SIM_IO(address) = value ;
+		Sim_lcdBusUpdate();
+		break;
+	default:
+		if(2 == width)
+		{
+			g_sim_io.word[address / 2] = value ;
+		}
+		else
+		{
+			SIM_IO(address) = value ;
+		}
+		break;
+	}
+}
+
+/* Inputs:
+ * 	1. address: I/O address of the register.
+ * 	2. value  : value read by the firmware.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for handle a register which was read or written back with the same value.
+ * 	The two cases can not be separated, so a flag read as one with its interrupt disabled is cleared,
+ * 	this matches the polling code which always clears the flag after seeing it.
+ */
+static void Sim_readSideEffects(uint8 address, uint8 value)
+{
+	if(0x06 == address)
+	{
+		if((value & (1<<ADIF)) && !(value & (1<<ADIE)))
+		{
+			SIM_IO(0x06) &= ~(1<<ADIF) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+	else if(0x38 == address)
+	{
+		SIM_IO(0x38) &= ~(value & ~SIM_IO(0x39)) ;
+	}
+	else if((0x0C == address) && !(SIM_IO(0x0B) & (1<<RXC)))
+	{
+		/* No received byte to be read, so UDR was written with the value of the receive buffer */
+		Sim_uartWriteData(value);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+/* Inputs: cycles: number of CPU cycles.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for move the simulated time forward, run the due peripheral events
+ * 	then serve the pending interrupts.
+ */
+static void Sim_advance(uint64 cycles)
+{
+	g_sim_statistics.cycles += cycles ;
+
+	if(g_sim_statistics.cycles >= g_sim_nextEvent)
+	{
+		Sim_processEvents();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	Sim_serveInterrupts();
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for set the peripheral flags of all events reached by the simulated time.
+ */
+static void Sim_processEvents(void)
+{
+	uint64 now = g_sim_statistics.cycles ;
+
+	if(now >= g_sim_cycleLimit)
+	{
+		Sim_finish();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	if(now >= g_sim_timer0OverflowEvent)
+	{
+		Sim_adcTriggerEvent(4, TOV0);
+		SIM_IO(0x38) |= (1<<TOV0) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	if(now >= g_sim_timer0CompareEvent)
+	{
+		Sim_adcTriggerEvent(3, OCF0);
+		SIM_IO(0x38) |= (1<<OCF0) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	Sim_timer0Reschedule();
+
+	if(now >= g_sim_timer1OverflowEvent)
+	{
+		SIM_IO(0x38) |= (1<<TOV1) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	if(now >= g_sim_timer1CompareAEvent)
+	{
+		SIM_IO(0x38) |= (1<<OCF1A) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	if(now >= g_sim_timer1CompareBEvent)
+	{
+		SIM_IO(0x38) |= (1<<OCF1B) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	Sim_timer1Reschedule();
+
+	if(now >= g_sim_icpEvent)
+	{
+		Sim_icpCapture();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	if(now >= g_sim_uartEvent)
+	{
+		Sim_uartCompleteFrame();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	if(now >= g_sim_adcEvent)
+	{
+		Sim_adcCompleteConversion();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	if(now >= g_sim_eepromEvent)
+	{
+		Sim_eepromCompleteWrite();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	Sim_updateNextEvent();
+}
+
+static void Sim_updateNextEvent(void)
+{
+	uint64 next = g_sim_cycleLimit ;
+
+	next = (g_sim_timer0OverflowEvent < next) ? g_sim_timer0OverflowEvent : next ;
+	next = (g_sim_timer0CompareEvent < next) ? g_sim_timer0CompareEvent : next ;
+	next = (g_sim_timer1OverflowEvent < next) ? g_sim_timer1OverflowEvent : next ;
+	next = (g_sim_timer1CompareAEvent < next) ? g_sim_timer1CompareAEvent : next ;
+	next = (g_sim_timer1CompareBEvent < next) ? g_sim_timer1CompareBEvent : next ;
+	next = (g_sim_icpEvent < next) ? g_sim_icpEvent : next ;
+	next = (g_sim_uartEvent < next) ? g_sim_uartEvent : next ;
+	next = (g_sim_adcEvent < next) ? g_sim_adcEvent : next ;
+	next = (g_sim_eepromEvent < next) ? g_sim_eepromEvent : next ;
+
+	g_sim_nextEvent = next ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for call the ISR of the enabled interrupts with a set flag, by their priority.
+ * 	The ISRs run with the global interrupts disabled, so they are never nested.
+ */
+static void Sim_serveInterrupts(void)
+{
+	uint8 index ;
+	uint8 slot ;
+	const Sim_InterruptType *interrupt ;
+
+	while((SIM_MAIN_CONTEXT == g_sim_context) && (SIM_IO(0x3F) & (1<<SREG_I)))
+	{
+		interrupt = NULL_PTR ;
+		for(index = 0 ; index < SIM_NUM_OF_INTERRUPTS ; index++)
+		{
+			if((SIM_IO(g_sim_interrupts[index].flag_address) & (1<<g_sim_interrupts[index].flag_bit)) &&
+			   (SIM_IO(g_sim_interrupts[index].enable_address) & (1<<g_sim_interrupts[index].enable_bit)))
+			{
+				interrupt = &g_sim_interrupts[index] ;
+				break;
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+		}
+
+		if(NULL_PTR == interrupt)
+		{
+			break;
+		}
+		else if(NULL_PTR == interrupt->handler)
+		{
+			fprintf(stderr, "sim: interrupt enabled without ISR (vector %u)\n", (unsigned)(interrupt - g_sim_interrupts));
+			exit(1);
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+
+		/* Most of the flags are cleared by the hardware when the vector is executed */
+		if(interrupt->auto_clear)
+		{
+			SIM_IO(interrupt->flag_address) &= ~(1<<interrupt->flag_bit) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+		SIM_IO(0x3F) &= ~(1<<SREG_I) ;
+		g_sim_context = SIM_ISR_CONTEXT ;
+		g_sim_statistics.interrupts++ ;
+		g_sim_statistics.cycles += SIM_CYCLES_PER_INTERRUPT ;
+
+		interrupt->handler();
+
+		/* Apply the last writes of the ISR then close its slots */
+		Sim_commitAccesses();
+		for(slot = 0 ; slot < SIM_OPEN_ACCESSES ; slot++)
+		{
+			g_sim_access[SIM_ISR_CONTEXT][slot].width = 0 ;
+		}
+		g_sim_context = SIM_MAIN_CONTEXT ;
+		SIM_IO(0x3F) |= (1<<SREG_I) ;
+
+		if(g_sim_statistics.cycles >= g_sim_nextEvent)
+		{
+			Sim_processEvents();
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+}
+
+static uint16 Sim_clockSelectToPrescaler(uint8 clock_select)
+{
+	static const uint16 prescaler[8] = {0, 1, 8, 64, 256, 1024, 0, 0} ;
+
+	/* The external clock sources are not simulated, the timer is stopped */
+	return prescaler[clock_select & 0x07] ;
+}
+
+static uint32 Sim_timerCount(const Sim_TimerType *timer)
+{
+	uint32 count = timer->start_count ;
+
+	if(timer->prescaler != 0)
+	{
+		count = (uint32)((timer->start_count + (g_sim_statistics.cycles - timer->start_cycle) / timer->prescaler) % timer->modulus) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return count ;
+}
+
+static void Sim_timerSetCount(Sim_TimerType *timer, uint32 count)
+{
+	timer->start_cycle = g_sim_statistics.cycles ;
+	timer->start_count = count % timer->modulus ;
+}
+
+static void Sim_timerSetPrescaler(Sim_TimerType *timer, uint16 prescaler)
+{
+	Sim_timerSetCount(timer, Sim_timerCount(timer));
+	timer->prescaler = prescaler ;
+}
+
+/* Inputs:
+ * 	1. timer: the timer model.
+ * 	2. value: counter value to match.
+ *
+ * Return Value: The next cycle at which the counter becomes equal to the value.
+ *
+ * Description:
+ * 	Function responsible for find the time of the next compare match or overflow of a running timer.
+ */
+static uint64 Sim_timerNextMatch(const Sim_TimerType *timer, uint32 value)
+{
+	uint64 ticks ;
+	uint64 current ;
+	uint64 next = SIM_NO_EVENT ;
+
+	if(timer->prescaler != 0)
+	{
+		ticks = (g_sim_statistics.cycles - timer->start_cycle) / timer->prescaler ;
+		current = (timer->start_count + ticks) % timer->modulus ;
+		ticks += ((value + timer->modulus - current - 1) % timer->modulus) + 1 ;
+		next = timer->start_cycle + (ticks * timer->prescaler) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return next ;
+}
+
+static void Sim_timer0Reschedule(void)
+{
+	g_sim_timer0OverflowEvent = Sim_timerNextMatch(&g_sim_timer0, 0);
+	g_sim_timer0CompareEvent = Sim_timerNextMatch(&g_sim_timer0, SIM_IO(0x3C));
+	Sim_updateNextEvent();
+}
+
+static void Sim_timer1Reschedule(void)
+{
+	g_sim_timer1OverflowEvent = Sim_timerNextMatch(&g_sim_timer1, 0);
+	g_sim_timer1CompareAEvent = Sim_timerNextMatch(&g_sim_timer1, g_sim_io.word[0x2A / 2]);
+	g_sim_timer1CompareBEvent = Sim_timerNextMatch(&g_sim_timer1, g_sim_io.word[0x28 / 2]);
+	Sim_updateNextEvent();
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for latch the ADMUX input and schedule the end of the conversion,
+ * 	the first conversion after enabling the ADC takes 25 ADC clocks and the next ones take 13.
+ */
+static void Sim_adcStartConversion(void)
+{
+	uint16 prescaler = 1 << (SIM_IO(0x06) & 0x07) ;
+	uint8 adc_clocks = (TRUE == g_sim_adcFirstConversion) ? 25 : 13 ;
+
+	if(prescaler < 2)
+	{
+		prescaler = 2 ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	g_sim_adcMux = SIM_IO(0x07) ;
+	g_sim_adcFirstConversion = FALSE ;
+	SIM_IO(0x06) |= (1<<ADSC) ;
+	g_sim_adcEvent = g_sim_statistics.cycles + ((uint64)adc_clocks * prescaler) ;
+	Sim_updateNextEvent();
+}
+
+/* Inputs:
+ * 	1. source: the ADTS2:0 value of the event.
+ * 	2. flag  : the TIFR flag which is about to be set by the event.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for start an auto triggered conversion on the rising edge of the trigger flag,
+ * 	the event is ignored if the flag is still set or a conversion is running.
+ */
+static void Sim_adcTriggerEvent(uint8 source, uint8 flag)
+{
+	uint8 control = SIM_IO(0x06) ;
+
+	if((control & (1<<ADEN)) && (control & (1<<ADATE)) && !(control & (1<<ADSC)) &&
+	   (source == (SIM_IO(0x30) >> 5)) && !(SIM_IO(0x38) & (1<<flag)))
+	{
+		Sim_adcStartConversion();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for store the result of the ADC model and set ADIF,
+ * 	in free running mode the next conversion starts directly.
+ */
+static void Sim_adcCompleteConversion(void)
+{
+	uint16 reference_mv ;
+	uint16 result ;
+
+	switch(g_sim_adcMux >> 6)
+	{
+	case 3:
+		reference_mv = g_sim_internalReferenceMillivolts ;
+		break;
+	default:
+		reference_mv = SIM_AVCC_MV ;
+		break;
+	}
+
+	result = g_sim_adcModel(g_sim_adcMux & 0x1F, reference_mv) & 0x3FF ;
+	g_sim_io.word[0x04 / 2] = (g_sim_adcMux & (1<<ADLAR)) ? (result << 6) : result ;
+	g_sim_statistics.adc_conversions++ ;
+
+	SIM_IO(0x06) |= (1<<ADIF) ;
+	g_sim_adcEvent = SIM_NO_EVENT ;
+
+	if((SIM_IO(0x06) & (1<<ADATE)) && (0 == (SIM_IO(0x30) >> 5)))
+	{
+		Sim_adcStartConversion();
+	}
+	else
+	{
+		SIM_IO(0x06) &= ~(1<<ADSC) ;
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for ask the tach model for the time of the next edge on ICP1 pin.
+ */
+static void Sim_icpSchedule(void)
+{
+	uint32 period_us = g_sim_tachModel(g_sim_statistics.cycles) ;
+
+	g_sim_icpEdge = (period_us != 0) ;
+	g_sim_icpEvent = g_sim_statistics.cycles + SIM_US_TO_CYCLES(g_sim_icpEdge ? period_us : SIM_TACH_RECHECK_US) ;
+	Sim_updateNextEvent();
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for copy Timer1 counter to ICR1 and set ICF1 at a tach edge, then schedule the next one.
+ * 	The edge select and the noise canceler are not simulated, every model edge is captured.
+ */
+static void Sim_icpCapture(void)
+{
+	if(g_sim_icpEdge && (g_sim_timer1.prescaler != 0))
+	{
+		g_sim_io.word[0x26 / 2] = (uint16)Sim_timerCount(&g_sim_timer1) ;
+		SIM_IO(0x38) |= (1<<ICF1) ;
+		g_sim_statistics.tach_edges++ ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	Sim_icpSchedule();
+}
+
+/* Inputs: data: byte written to UDR.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for move the byte to the transmit shift register or to the transmit buffer.
+ * 	A byte written while UDRE is cleared is lost, the same as the hardware.
+ */
+static void Sim_uartWriteData(uint8 data)
+{
+	if(!(SIM_IO(0x0A) & (1<<TXEN)))
+	{
+		/* Do Nothing. */
+	}
+	else if(FALSE == g_sim_uartShiftFull)
+	{
+		g_sim_uartShift = data ;
+		g_sim_uartShiftFull = TRUE ;
+		Sim_uartStartFrame();
+	}
+	else if(FALSE == g_sim_uartBufferFull)
+	{
+		g_sim_uartBuffer = data ;
+		g_sim_uartBufferFull = TRUE ;
+		SIM_IO(0x0B) &= ~(1<<UDRE) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for schedule the end of the frame in the shift register from the baud rate and the frame format.
+ */
+static void Sim_uartStartFrame(void)
+{
+	uint16 ubrr = ((uint16)(SIM_IO(0x20) & 0x0F) << 8) | SIM_IO(0x09) ;
+	uint8 bits = 1 + 5 + ((g_sim_uartControlC >> UCSZ0) & 0x03) + ((SIM_IO(0x0A) & (1<<UCSZ2)) ? 1 : 0) ;
+
+	bits += ((g_sim_uartControlC & (1<<UPM1)) ? 1 : 0) + ((g_sim_uartControlC & (1<<USBS)) ? 2 : 1) ;
+	g_sim_uartEvent = g_sim_statistics.cycles +
+					  (uint64)bits * ((SIM_IO(0x0B) & (1<<U2X)) ? 8 : 16) * (ubrr + 1) ;
+	Sim_updateNextEvent();
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for give the sent byte to the UART model, then load the transmit buffer
+ * 	to the shift register or set TXC when there is nothing more to send.
+ */
+static void Sim_uartCompleteFrame(void)
+{
+	g_sim_uartModel(g_sim_uartShift, g_sim_statistics.cycles);
+	g_sim_statistics.uart_bytes++ ;
+
+	if(g_sim_uartBufferFull)
+	{
+		g_sim_uartShift = g_sim_uartBuffer ;
+		g_sim_uartBufferFull = FALSE ;
+		SIM_IO(0x0B) |= (1<<UDRE) ;
+		Sim_uartStartFrame();
+	}
+	else
+	{
+		g_sim_uartShiftFull = FALSE ;
+		g_sim_uartEvent = SIM_NO_EVENT ;
+		SIM_IO(0x0B) |= (1<<TXC) ;
+	}
+}
+
+/* Inputs:
+ * 	1. old  : EECR value before the write.
+ * 	2. value: value written by the firmware.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for start an EEPROM read or write as the EECR bits ask.
+ * 	EEMWE is not kept in the register, it only opens the window where EEWE starts the write.
+ * 	A write takes SIM_EEPROM_WRITE_US, EEWE stays set and the EE_RDY interrupt waits until its end.
+ */
+static void Sim_eepromControlWrite(uint8 old, uint8 value)
+{
+	uint16 address = g_sim_io.word[0x1E / 2] % SIM_EEPROM_SIZE ;
+
+	SIM_IO(0x1C) = (value & (1<<EERIE)) | (old & ((1<<EEWE) | (1<<SIM_EECR_READY))) ;
+
+	if(old & (1<<EEWE))
+	{
+		/* The EEPROM ignores the new requests during a write */
+	}
+	else if((value & (1<<EEWE)) && (g_sim_statistics.cycles <= g_sim_eepromMasterEnd))
+	{
+		g_sim_eepromWriteAddress = address ;
+		g_sim_eepromWriteData = SIM_IO(0x1D) ;
+		SIM_IO(0x1C) = (SIM_IO(0x1C) | (1<<EEWE)) & ~(1<<SIM_EECR_READY) ;
+		g_sim_eepromEvent = g_sim_statistics.cycles + SIM_US_TO_CYCLES(SIM_EEPROM_WRITE_US) ;
+		Sim_updateNextEvent();
+	}
+	else if(value & (1<<EEMWE))
+	{
+		g_sim_eepromMasterEnd = g_sim_statistics.cycles + SIM_EEPROM_MASTER_CYCLES ;
+	}
+	else if(value & (1<<EERE))
+	{
+		SIM_IO(0x1D) = g_sim_eeprom[address] ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+/* Store the byte at the end of the write, the EEPROM is ready again */
+static void Sim_eepromCompleteWrite(void)
+{
+	g_sim_eeprom[g_sim_eepromWriteAddress] = g_sim_eepromWriteData ;
+	g_sim_statistics.eeprom_writes++ ;
+	SIM_IO(0x1C) = (SIM_IO(0x1C) & ~(1<<EEWE)) | (1<<SIM_EECR_READY) ;
+	g_sim_eepromEvent = SIM_NO_EVENT ;
+}
+
+/* Inputs:
+ * 	1. tccr    : TCCR0 or TCCR2 value, both timers have the same mode and output bits.
+ * 	2. compare : OCR0 or OCR2 value.
+ * 	3. pin_high: the PORT value of the output pin.
+ *
+ * Return Value: The duty of the output in 1/256 steps of the period.
+ *
+ * Description:
+ * 	Function responsible for find the duty of an 8-bit timer output from its mode and compare value.
+ */
+static uint16 Sim_pwmOutputDuty(uint8 tccr, uint8 compare, boolean pin_high)
+{
+	uint8 output_mode = (tccr >> COM00) & 0x03 ;
+	uint16 duty = pin_high ? 256 : 0 ;
+
+	if((0 == (tccr & 0x07)) || (output_mode < 2))
+	{
+		/* Timer stopped or output disconnected, the pin keeps its port value */
+	}
+	else if((tccr & (1<<WGM00)) && (tccr & (1<<WGM01)))
+	{
+		/* Fast PWM */
+		duty = compare + 1 ;
+		duty = (2 == output_mode) ? duty : (256 - duty) ;
+	}
+	else if(tccr & (1<<WGM00))
+	{
+		/* Phase correct PWM */
+		duty = (uint16)((compare * 256UL) / 255) ;
+		duty = (2 == output_mode) ? duty : (256 - duty) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return duty ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for find the OC0 and OC2 duties then inform the PWM model of each changed one.
+ */
+static void Sim_pwmUpdate(void)
+{
+	uint16 duty[SIM_NUM_OF_PWM_OUTPUTS] ;
+	uint8 output ;
+
+	duty[SIM_PWM_OC0] = Sim_pwmOutputDuty(SIM_IO(0x33), SIM_IO(0x3C), (SIM_IO(0x18) & (1<<PIN3_ID)) != 0) ;
+	duty[SIM_PWM_OC2] = Sim_pwmOutputDuty(SIM_IO(0x25), SIM_IO(0x23), (SIM_IO(0x12) & (1<<PIN7_ID)) != 0) ;
+
+	for(output = 0 ; output < SIM_NUM_OF_PWM_OUTPUTS ; output++)
+	{
+		if(duty[output] != g_sim_pwmDuty[output])
+		{
+			g_sim_statistics.pwm_updates++ ;
+			g_sim_pwmModel(output, duty[output], g_sim_statistics.cycles);
+			g_sim_pwmDuty[output] = duty[output] ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+}
+
+/* Inputs: port_num: Port ID.
+ *
+ * Return Value: Levels the port drives on its pins.
+ *
+ * Description:
+ * 	Function responsible for give the PORTx register value with the pins taken by the USART overridden,
+ * 	the transmitter holds TXD at the idle high level and the receiver leaves RXD pulled up by the line.
+ */
+static uint8 Sim_portOutput(uint8 port_num)
+{
+	uint8 value = SIM_IO(SIM_PORT_ADDRESS(port_num)) ;
+
+	if(UART_PORT_ID == port_num)
+	{
+		if(SIM_IO(0x0A) & (1<<TXEN))
+		{
+			value |= (1<<UART_TXD_PIN_ID) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+
+		if(SIM_IO(0x0A) & (1<<RXEN))
+		{
+			value |= (1<<UART_RXD_PIN_ID) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return value ;
+}
+
+/* Inputs: void.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Function responsible for watch the E pin of the LCD and latch the RS and data pins at its falling edge,
+ * 	the busy flag is driven on the data pins while E is high in a read cycle.
+ */
+static void Sim_lcdBusUpdate(void)
+{
+	uint8 enable = (Sim_portOutput(LCD_E_PORT_ID) >> LCD_E_PIN_ID) & 0x01 ;
+	uint8 rs = (Sim_portOutput(LCD_RS_PORT_ID) >> LCD_RS_PIN_ID) & 0x01 ;
+	uint8 data = Sim_portOutput(LCD_DATA_PORT_ID) ;
+	uint8 read = LOGIC_LOW ;
+	uint8 data_mask ;
+	uint8 busy_mask ;
+
+#if(LCD_BUSY_FLAG_ENABLED == LCD_BUSY_FLAG_MODE)
+	read = (Sim_portOutput(LCD_RW_PORT_ID) >> LCD_RW_PIN_ID) & 0x01 ;
+#endif
+
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
+	data_mask = 0xFF ;
+	busy_mask = 0x80 ;
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+	data_mask = 0x0F << LCD_DATA_PIN1_ID ;
+	busy_mask = (1<<LCD_DATA_PIN4_ID) ;
+	data = (data >> LCD_DATA_PIN1_ID) & 0x0F ;
+#endif
+
+	if(enable == g_sim_lcdEnable)
+	{
+		/* No edge on E */
+	}
+	else if(LOGIC_HIGH == read)
+	{
+		/* The LCD drives the data bus while E is high, only the busy flag is given and the address counter reads zero */
+		g_sim_pinDriveMask[LCD_DATA_PORT_ID] = (LOGIC_HIGH == enable) ? data_mask : 0 ;
+		g_sim_pinDriveValue[LCD_DATA_PORT_ID] = (g_sim_statistics.cycles < g_sim_lcdBusyUntil) ? busy_mask : 0 ;
+	}
+	else if(LOGIC_LOW == enable)
+	{
+#if(LCD_TWO_LINES_EIGHT_BITS_MODE == LCD_DATA_BITS_MODE)
+		Sim_lcdLatch(rs, data);
+#elif(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+		if(TRUE == g_sim_lcdEightBitsInterface)
+		{
+			/* DB3..DB0 are not connected and read as zero */
+			Sim_lcdLatch(rs, data << 4);
+		}
+		else if(FALSE == g_sim_lcdSecondNibble)
+		{
+			g_sim_lcdHighNibble = data ;
+			g_sim_lcdSecondNibble = TRUE ;
+		}
+		else
+		{
+			g_sim_lcdSecondNibble = FALSE ;
+			Sim_lcdLatch(rs, (g_sim_lcdHighNibble << 4) | data);
+		}
+#endif
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	g_sim_lcdEnable = enable ;
+}
+
+static void Sim_lcdLatch(uint8 rs, uint8 data)
+{
+	/* The function set command selects the interface width of the next transfers */
+	if((LOGIC_LOW == rs) && (0x20 == (data & 0xE0)))
+	{
+		g_sim_lcdEightBitsInterface = (data & 0x10) ? TRUE : FALSE ;
+#if(LCD_TWO_LINES_FOUR_BITS_MODE == LCD_DATA_BITS_MODE)
+		g_sim_lcdSecondNibble = FALSE ;
+#endif
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	g_sim_statistics.lcd_bytes++ ;
+	g_sim_lcdBusyUntil = g_sim_statistics.cycles + SIM_US_TO_CYCLES(g_sim_lcdModel(rs, data)) ;
+}
+
+/* Inputs:
+ * 	1. mux         : ADMUX MUX4:0 bits.
+ * 	2. reference_mv: ADC reference voltage.
+ *
+ * Return Value: The conversion result.
+ *
+ * Description:
+ * 	Default ADC model, the single ended and the differential inputs read the pin voltages set by
+ * 	Sim_setAdcInputMillivolts and the bandgap input reads SIM_BANDGAP_MV.
+ */
+static uint16 Sim_defaultAdcModel(uint8_t mux, uint16_t reference_mv)
+{
+	sint32 result = 0 ;
+	sint32 microvolts ;
+	uint16 gain ;
+
+	if(mux < 8)
+	{
+		result = (sint32)(((uint64)Sim_adcPinMicrovolts(mux) * 1024) / ((uint32)reference_mv * 1000)) ;
+		result = (result > 1023) ? 1023 : result ;
+	}
+	else if(mux < 0x1E)
+	{
+		/* Differential inputs: 0x08..0x0F ADC1 or ADC3 against ADC0 or ADC2 with 10x or 200x gain,
+		 * 0x10..0x1D any pin against ADC1 or ADC2 with 1x gain */
+		if(mux < 0x10)
+		{
+			microvolts = Sim_adcPinMicrovolts(((mux & 0x04) >> 1) | (mux & 0x01)) - Sim_adcPinMicrovolts((mux & 0x04) >> 1) ;
+			gain = (mux & 0x02) ? 200 : 10 ;
+		}
+		else
+		{
+			microvolts = Sim_adcPinMicrovolts(mux & 0x07) - Sim_adcPinMicrovolts((mux < 0x18) ? 1 : 2) ;
+			gain = 1 ;
+		}
+		result = (sint32)(((sint64)microvolts * gain * 512) / ((sint32)reference_mv * 1000)) ;
+		result = (result < -512) ? -512 : ((result > 511) ? 511 : result) ;
+
+		/* Two's complement 10-bit result */
+		result &= 0x3FF ;
+	}
+	else if(0x1E == mux)
+	{
+		result = ((uint32)SIM_BANDGAP_MV * 1024) / reference_mv ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return (uint16)result ;
+}
+
+/* Inputs:
+ * 	1. pin: ADC0..ADC7 pin.
+ *
+ * Return Value: The pin voltage in microvolts with the noise.
+ *
+ * Description:
+ * 	Function responsible for add the noise and the spikes of the default ADC model to the pin voltage,
+ * 	a fixed seed keeps the runs repeatable.
+ */
+static sint32 Sim_adcPinMicrovolts(uint8 pin)
+{
+	sint32 microvolts = (sint32)g_sim_adcInputMillivolts[pin] * 1000 ;
+	uint32 span ;
+
+	/* Uniform noise before the quantization and rare spikes */
+	g_sim_adcNoiseSeed = g_sim_adcNoiseSeed * 1103515245UL + 12345 ;
+	span = (uint32)g_sim_adcNoiseMillivolts * 2000 + 1 ;
+	microvolts += (sint32)(((g_sim_adcNoiseSeed >> 8) & 0xFFFFFF) % span) - (sint32)(span / 2) ;
+	microvolts = (microvolts < 0) ? 0 : microvolts ;
+	if(0 == ((g_sim_adcNoiseSeed >> 24) % SIM_ADC_SPIKE_PERIOD))
+	{
+		microvolts += (sint32)g_sim_adcSpikeMillivolts * 1000 ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return microvolts ;
+}
+
+/* Inputs:
+ * 	1. output: SIM_PWM_OC0 or SIM_PWM_OC2.
+ * 	2. duty  : new duty in 1/256 steps.
+ * 	3. cycle : simulated time of the change.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Default PWM model, it accumulates the duty of each output over the time for the average.
+ */
+static void Sim_defaultPwmModel(uint8_t output, uint16_t duty, uint64_t cycle)
+{
+	g_sim_pwmDutyCycles[output] += (uint64)g_sim_pwmDuty[output] * (cycle - g_sim_pwmLastCycle[output]) ;
+	g_sim_pwmLastCycle[output] = cycle ;
+	(void)duty ;
+}
+
+/* Inputs:
+ * 	1. rs  : register select, 0 for command and 1 for data.
+ * 	2. data: latched byte.
+ *
+ * Return Value: Execution time in microseconds.
+ *
+ * Description:
+ * 	Default LCD model, an HD44780 controller with two lines display data RAM.
+ * 	The character generator RAM and the display shift are not simulated.
+ */
+static uint16 Sim_defaultLcdModel(uint8_t rs, uint8_t data)
+{
+	uint16 execution_time = 37 ;
+
+	if(LOGIC_HIGH == rs)
+	{
+		if(FALSE == g_sim_lcdCgramSelected)
+		{
+			g_sim_lcdDdram[g_sim_lcdAddress] = data ;
+			g_sim_lcdAddress = (0x27 == g_sim_lcdAddress) ? 0x40 :
+							   (0x67 == g_sim_lcdAddress) ? 0x00 : (g_sim_lcdAddress + 1) ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+		execution_time = 41 ;
+	}
+	else if(data & 0x80)
+	{
+		g_sim_lcdAddress = data & 0x7F ;
+		g_sim_lcdCgramSelected = FALSE ;
+	}
+	else if(data & 0x40)
+	{
+		g_sim_lcdCgramSelected = TRUE ;
+	}
+	else if(0x01 == data)
+	{
+		memset(g_sim_lcdDdram, ' ', sizeof(g_sim_lcdDdram));
+		g_sim_lcdAddress = 0 ;
+		execution_time = 1520 ;
+	}
+	else if(0x02 == (data & 0xFE))
+	{
+		g_sim_lcdAddress = 0 ;
+		execution_time = 1520 ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return execution_time ;
+}
+
+/* Inputs: cycle: simulated time of the edge.
+ *
+ * Return Value: Microseconds to the next tach edge, ZERO if the fan is stopped.
+ *
+ * Description:
+ * 	Default tach model, a fan which speed follows OC0 duty without inertia.
+ */
+static uint32_t Sim_defaultTachModel(uint64_t cycle)
+{
+	uint32 rpm = ((uint32)SIM_FAN_FULL_SPEED_RPM * g_sim_pwmDuty[SIM_PWM_OC0]) / 256 ;
+	uint32 period_us = 0 ;
+
+	if(g_sim_pwmDuty[SIM_PWM_OC0] >= SIM_FAN_START_DUTY)
+	{
+		period_us = 60000000UL / (rpm * SIM_FAN_PULSES_PER_REV) ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	(void)cycle ;
+
+	return period_us ;
+}
+
+/* Inputs:
+ * 	1. data : byte sent on TXD pin.
+ * 	2. cycle: simulated time of the stop bit end.
+ *
+ * Return Value: void.
+ *
+ * Description:
+ * 	Default UART model, it writes the sent bytes to the output file if one is set.
+ */
+static void Sim_defaultUartModel(uint8_t data, uint64_t cycle)
+{
+	if(g_sim_uartOutputFd >= 0)
+	{
+		if(write(g_sim_uartOutputFd, &data, 1) != 1)
+		{
+			g_sim_uartOutputFd = -1 ;
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	(void)cycle ;
+}
@@ -0,0 +1,150 @@
+/*
+ ============================================================================
+ Name        : sim.h
+ Author      : Ahmed Shawky
+ Description : Header File for the Host Simulation of the ATmega32 registers
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdint.h>
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* Simulated CPU cycles charged for each register access, the code between two accesses is not timed */
+#define SIM_CYCLES_PER_ACCESS			4
+
+/* Simulated CPU cycles charged for entering and leaving an interrupt service routine */
+#define SIM_CYCLES_PER_INTERRUPT		10
+
+/* Voltage of AVCC and AREF pins in the simulated board */
+#define SIM_AVCC_MV						5000
+
+/* Internal bandgap voltage, the internal reference is 2560 mV unless Sim_setInternalReferenceMillivolts changes it */
+#define SIM_BANDGAP_MV					1220
+
+/* EEPROM size in bytes and the time of one byte write, the EEPROM is erased (0xFF) after Sim_init */
+#define SIM_EEPROM_SIZE					1024
+#define SIM_EEPROM_WRITE_US				8500
+
+/* PWM outputs of the 8-bit timers, OC0 of Timer0 and OC2 of Timer2 */
+#define SIM_PWM_OC0						0
+#define SIM_PWM_OC2						1
+#define SIM_NUM_OF_PWM_OUTPUTS			2
+
+/* Default ADC model: average number of conversions between two noise spikes */
+#define SIM_ADC_SPIKE_PERIOD			256
+
+/* Default fan model: the speed is proportional to OC0 duty, the fan does not turn below the start duty */
+#define SIM_FAN_FULL_SPEED_RPM			3000
+#define SIM_FAN_START_DUTY				20
+#define SIM_FAN_PULSES_PER_REV			2
+
+/* The tach model is asked again after this time when the fan is stopped */
+#define SIM_TACH_RECHECK_US				10000
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+
+/* ADC input model: returns the 10-bit conversion result of the MUX4:0 input for the used reference */
+typedef uint16_t (*Sim_AdcModelType)(uint8_t mux, uint16_t reference_mv);
+
+/* PWM output model: called when the duty of OC0 or OC2 is changed by the timer mode or the compare value,
+ * duty is in 1/256 steps of the period */
+typedef void (*Sim_PwmModelType)(uint8_t output, uint16_t duty, uint64_t cycle);
+
+/* LCD controller model: called with every byte latched by the LCD, returns its execution time in microseconds */
+typedef uint16_t (*Sim_LcdModelType)(uint8_t rs, uint8_t data);
+
+/* Fan tachometer model: called at each captured edge of ICP1 pin, returns the microseconds to the next one,
+ * ZERO when the fan is stopped */
+typedef uint32_t (*Sim_TachModelType)(uint64_t cycle);
+
+/* USART transmitter model: called with every byte sent on TXD pin at the end of its frame,
+ * the receiver is not simulated */
+typedef void (*Sim_UartModelType)(uint8_t data, uint64_t cycle);
+
+/* Finish hook: called by Sim_finish after the report, it returns the exit status of the simulation */
+typedef int (*Sim_FinishHookType)(void);
+
+typedef struct
+{
+	uint64_t cycles ;
+	uint64_t register_accesses ;
+	uint64_t interrupts ;
+	uint64_t sleep_cycles ;
+	uint64_t adc_conversions ;
+	uint64_t pwm_updates ;
+	uint64_t lcd_bytes ;
+	uint64_t tach_edges ;
+	uint64_t uart_bytes ;
+	uint64_t eeprom_writes ;
+}Sim_StatisticsType;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Used by <avr/io.h>, return the simulated 8-bit or 16-bit register at the I/O address */
+volatile uint8_t *Sim_accessRegister(uint8_t address);
+volatile uint16_t *Sim_accessRegister16(uint8_t address);
+
+/* Used by <util/delay.h>, advance the simulated time while serving the interrupts */
+void Sim_delayCycles(uint64_t cycles);
+
+/* Used by <avr/sleep.h>, the CPU sleeps until an interrupt is served, all sleep modes are simulated as Idle */
+void Sim_sleep(void);
+
+/* Used by <avr/eeprom.h>, the update functions write only the changed bytes and advance the simulated time */
+uint8_t Sim_eepromReadByte(uint16_t address);
+uint16_t Sim_eepromReadWord(uint16_t address);
+void Sim_eepromUpdateByte(uint16_t address, uint8_t value);
+void Sim_eepromUpdateWord(uint16_t address, uint16_t value);
+
+/* The EEPROM content, it can be loaded after Sim_init and saved at the end to keep it between the runs */
+uint8_t *Sim_getEeprom(void);
+
+/* Reset the simulated MCU, the simulation ends with a report after cycle_limit cycles */
+void Sim_init(uint64_t cycle_limit);
+
+void Sim_setAdcModel(Sim_AdcModelType model);
+void Sim_setPwmModel(Sim_PwmModelType model);
+void Sim_setLcdModel(Sim_LcdModelType model);
+void Sim_setTachModel(Sim_TachModelType model);
+void Sim_setUartModel(Sim_UartModelType model);
+void Sim_setFinishHook(Sim_FinishHookType hook);
+
+/* Default UART model: the sent bytes are written to the file descriptor, a negative one discards them */
+void Sim_setUartOutput(int fd);
+
+/* Default ADC model: the voltage applied on one of ADC0..ADC7 pins */
+void Sim_setAdcInputMillivolts(uint8_t channel, uint16_t millivolts);
+void Sim_setAdcNoiseMillivolts(uint16_t peak_millivolts);
+void Sim_setAdcSpikeMillivolts(uint16_t spike_millivolts);
+
+/* The real voltage of the 2.56V internal reference of the simulated part, it is used by all the ADC models */
+void Sim_setInternalReferenceMillivolts(uint16_t millivolts);
+
+/* Default PWM model: the last duty of SIM_PWM_OC0 or SIM_PWM_OC2 and its average over the simulated time */
+uint16_t Sim_getPwmDuty(uint8_t output);
+double Sim_getPwmAverageDuty(uint8_t output);
+
+/* Default LCD model: the text shown on one row of the HD44780 display */
+const char *Sim_getLcdRow(uint8_t row);
+
+const Sim_StatisticsType *Sim_getStatistics(void);
+
+/* End the simulation, print the report and exit the process with the finish hook status */
+void Sim_finish(void);
+
+
+#endif /* SIM_H_ */
@@ -0,0 +1,483 @@
+/*
+ ============================================================================
+ Name        : sim_main.c
+ Author      : Ahmed Shawky
+ Description : Host Simulation entry point, it runs the firmware main function
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "sim.h"
+#include "lm35_sensor.h"
+#include "dc_motor.h"
+#include "telemetry.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* Thermal plant: each zone is a heated box cooled by its fan, it settles at 70 C with the fan
+ * stopped and at 30 C with the fan at full speed */
+#define PLANT_AMBIENT_C					25.0
+#define PLANT_HEATER_W					9.0
+#define PLANT_CAPACITY_J_PER_C			50.0
+#define PLANT_NATURAL_W_PER_C			0.2
+#define PLANT_FAN_W_PER_C				1.6
+
+/* The temperature is settled when it stays in this band around the setpoint */
+#define PLANT_SETTLING_BAND_C			0.5
+
+#define PLANT_NUM_OF_ZONES				LM35_NUM_OF_SENSORS
+
+/* The ADC input of each zone sensor and the PWM output of each zone fan */
+#define PLANT_SENSOR_CHANNEL(channel)	(channel),
+#define PLANT_FAN_OUTPUT(in_port, in1_pin, in2_pin, pwm_channel) \
+	((DC_MOTOR_PWM_OC0 == (pwm_channel)) ? SIM_PWM_OC0 : SIM_PWM_OC2),
+
+/* Maximum number of -L texts */
+#define CHECK_MAX_LCD_TEXTS				4
+
+/* Exit status of a simulation which breaks one of the checks */
+#define CHECK_FAILED_STATUS				3
+
+#if (LM35_NUM_OF_SENSORS != DC_MOTOR_NUM_OF_ZONES)
+#error "Each plant zone should have one LM35 sensor and one fan"
+#endif
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef struct
+{
+	double temperature ;
+	double overshoot ;
+	double last_outside_band ;
+	uint64_t last_cycle ;
+}Plant_ZoneType;
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static const uint8_t g_plant_channels[PLANT_NUM_OF_ZONES] = { LM35_SENSORS(PLANT_SENSOR_CHANNEL) } ;
+static const uint8_t g_plant_fanOutputs[PLANT_NUM_OF_ZONES] = { DC_MOTOR_ZONES(PLANT_FAN_OUTPUT) } ;
+static Plant_ZoneType g_plant_zones[PLANT_NUM_OF_ZONES] ;
+static boolean g_plant_enabled = 0 ;
+static double g_plant_setpoint = 40.0 ;
+static double g_plant_initial ;
+
+/* Bounds checked at the end of the simulation, a negative bound is not checked */
+static double g_check_maxOvershoot = -1 ;
+static double g_check_maxSettling = -1 ;
+static long g_check_maxDroppedFrames = -1 ;
+static const char *g_check_lcdTexts[CHECK_MAX_LCD_TEXTS] ;
+static uint8_t g_check_lcdTextsCount = 0 ;
+
+/* File which keeps the EEPROM content between the runs */
+static const char *g_eeprom_path = NULL ;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* The firmware main function, renamed by the build */
+int App_main();
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Integrate the zone temperature from its last update with the current duty of its fan,
+ * then update its overshoot and settling time */
+static void Plant_updateZone(uint8_t zone, uint64_t cycle)
+{
+	Plant_ZoneType *zone_ptr = &g_plant_zones[zone] ;
+	double seconds = (double)(cycle - zone_ptr->last_cycle) / F_CPU ;
+	double fan = Sim_getPwmDuty(g_plant_fanOutputs[zone]) / 256.0 ;
+	double cooling = (PLANT_NATURAL_W_PER_C + PLANT_FAN_W_PER_C * fan) * (zone_ptr->temperature - PLANT_AMBIENT_C) ;
+	double deviation ;
+
+	zone_ptr->last_cycle = cycle ;
+	zone_ptr->temperature += (PLANT_HEATER_W - cooling) * seconds / PLANT_CAPACITY_J_PER_C ;
+
+	/* Overshoot is the deviation to the other side of the setpoint after the first crossing */
+	deviation = zone_ptr->temperature - g_plant_setpoint ;
+	if((deviation > 0) != (g_plant_initial > g_plant_setpoint))
+	{
+		zone_ptr->overshoot = (deviation * deviation > zone_ptr->overshoot * zone_ptr->overshoot) ? deviation : zone_ptr->overshoot ;
+	}
+	if((deviation > PLANT_SETTLING_BAND_C) || (deviation < -PLANT_SETTLING_BAND_C))
+	{
+		zone_ptr->last_outside_band = (double)cycle / F_CPU ;
+	}
+}
+
+/* ADC model of the LM35 sensors inside the thermal plant zones, a zone is updated at each conversion of its sensor */
+static uint16_t Plant_adcModel(uint8_t mux, uint16_t reference_mv)
+{
+	uint64_t cycle = Sim_getStatistics()->cycles ;
+	uint8_t zone = 0 ;
+	double code = 0 ;
+
+	while((zone < PLANT_NUM_OF_ZONES) && (g_plant_channels[zone] != mux))
+	{
+		zone++ ;
+	}
+
+	if(zone < PLANT_NUM_OF_ZONES)
+	{
+		Plant_updateZone(zone, cycle);
+		if(ADC_INPUT_IS_DIFFERENTIAL(mux))
+		{
+			/* The gain stage measures the LM35 against its reference pin, the 10-bit result is signed */
+			code = (g_plant_zones[zone].temperature * 10 - LM35_REFERENCE_MV) * ADC_INPUT_GAIN(mux) * 512 / reference_mv ;
+			code = (code < -512) ? -512 : ((code > 511) ? 511 : code) ;
+			code = (code < 0) ? (code + 1024) : code ;
+		}
+		else
+		{
+			code = g_plant_zones[zone].temperature * 10 * 1024 / reference_mv ;
+		}
+	}
+	else if(ADC_BANDGAP_CHANNEL == mux)
+	{
+		code = (double)SIM_BANDGAP_MV * 1024 / reference_mv ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+	code = (code < 0) ? 0 : ((code > 1023) ? 1023 : code) ;
+
+	return (uint16_t)code ;
+}
+
+/* A zone is settled when its temperature is in the band at the end of the simulation */
+static boolean Plant_isSettled(uint8_t zone)
+{
+	double error = g_plant_zones[zone].temperature - g_plant_setpoint ;
+
+	return (error <= PLANT_SETTLING_BAND_C) && (error >= -PLANT_SETTLING_BAND_C) ;
+}
+
+static void Plant_report(void)
+{
+	double seconds = (double)Sim_getStatistics()->cycles / F_CPU ;
+	const Plant_ZoneType *zone_ptr ;
+	uint8_t zone ;
+
+	for(zone = 0 ; zone < PLANT_NUM_OF_ZONES ; zone++)
+	{
+		zone_ptr = &g_plant_zones[zone] ;
+		printf("Zone %u plant      : %.2f C (setpoint %.2f C, start %.2f C)\n", zone + 1, zone_ptr->temperature,
+				g_plant_setpoint, g_plant_initial);
+		printf("Zone %u overshoot  : %.2f C\n", zone + 1, (zone_ptr->overshoot < 0) ? -zone_ptr->overshoot : zone_ptr->overshoot);
+		if(Plant_isSettled(zone))
+		{
+			printf("Zone %u settling   : %.1f s (band +/-%.1f C)\n", zone + 1, zone_ptr->last_outside_band, PLANT_SETTLING_BAND_C);
+		}
+		else
+		{
+			printf("Zone %u settling   : not settled in %.1f s\n", zone + 1, seconds);
+		}
+	}
+}
+
+/* Finish hook of the simulation, it prints the plant report then checks the bounds given on the command line */
+static int Check_results(void)
+{
+	int status = 0 ;
+	double overshoot ;
+	const Plant_ZoneType *zone_ptr ;
+	uint16 dropped_frames = Telemetry_getDroppedFrames() ;
+	uint8_t zone ;
+	uint8_t index ;
+
+	if(g_plant_enabled)
+	{
+		Plant_report();
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	for(zone = 0 ; g_plant_enabled && (zone < PLANT_NUM_OF_ZONES) ; zone++)
+	{
+		zone_ptr = &g_plant_zones[zone] ;
+		overshoot = (zone_ptr->overshoot < 0) ? -zone_ptr->overshoot : zone_ptr->overshoot ;
+		if((g_check_maxOvershoot >= 0) && (overshoot > g_check_maxOvershoot))
+		{
+			printf("Check failed      : zone %u overshoot %.2f C is above %.2f C\n", zone + 1, overshoot, g_check_maxOvershoot);
+			status = CHECK_FAILED_STATUS ;
+		}
+		if((g_check_maxSettling >= 0) && (!Plant_isSettled(zone) || (zone_ptr->last_outside_band > g_check_maxSettling)))
+		{
+			printf("Check failed      : zone %u is not settled in %.1f s\n", zone + 1, g_check_maxSettling);
+			status = CHECK_FAILED_STATUS ;
+		}
+	}
+
+	printf("Dropped frames    : %u\n", dropped_frames);
+	if((g_check_maxDroppedFrames >= 0) && (dropped_frames > g_check_maxDroppedFrames))
+	{
+		printf("Check failed      : %u telemetry frames dropped, the limit is %ld\n", dropped_frames, g_check_maxDroppedFrames);
+		status = CHECK_FAILED_STATUS ;
+	}
+
+	/* Sim_getLcdRow returns the same buffer for every row, so the rows are searched one by one */
+	for(index = 0 ; index < g_check_lcdTextsCount ; index++)
+	{
+		if((NULL == strstr(Sim_getLcdRow(0), g_check_lcdTexts[index])) &&
+		   (NULL == strstr(Sim_getLcdRow(1), g_check_lcdTexts[index])))
+		{
+			printf("Check failed      : the LCD does not show \"%s\"\n", g_check_lcdTexts[index]);
+			status = CHECK_FAILED_STATUS ;
+		}
+	}
+
+	fflush(stdout);
+
+	return status ;
+}
+
+/* Tach model of a blocked fan, it never gives an edge */
+static uint32_t Fan_stalledTachModel(uint64_t cycle)
+{
+	(void)cycle ;
+
+	return 0 ;
+}
+
+/* Load the EEPROM content saved by the last run, a missing file leaves the EEPROM erased */
+static void Eeprom_load(void)
+{
+	FILE *file = fopen(g_eeprom_path, "rb") ;
+
+	if(file != NULL)
+	{
+		if(fread(Sim_getEeprom(), 1, SIM_EEPROM_SIZE, file) != SIM_EEPROM_SIZE)
+		{
+			printf("EEPROM file %s is shorter than %u bytes\n", g_eeprom_path, SIM_EEPROM_SIZE);
+		}
+		fclose(file);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+static void Eeprom_save(void)
+{
+	FILE *file = fopen(g_eeprom_path, "wb") ;
+
+	if(file != NULL)
+	{
+		fwrite(Sim_getEeprom(), 1, SIM_EEPROM_SIZE, file);
+		fclose(file);
+	}
+	else
+	{
+		printf("EEPROM file %s can not be written\n", g_eeprom_path);
+	}
+}
+
+/* Open the file or the serial port which receives the UART bytes, a terminal is set to raw mode */
+static int Uart_openOutput(const char *path)
+{
+	struct termios settings ;
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_NOCTTY, 0644) ;
+
+	if((fd >= 0) && isatty(fd) && (0 == tcgetattr(fd, &settings)))
+	{
+		cfmakeraw(&settings);
+		cfsetospeed(&settings, B9600);
+		tcsetattr(fd, TCSANOW, &settings);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return fd ;
+}
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+int main(int argc, char *argv[])
+{
+	double seconds = 10.0 ;
+	double celsius = 25.0 ;
+	boolean stalled = 0 ;
+	const char *uart_path = NULL ;
+	double noise = 0 ;
+	double spike = 0 ;
+	double reference = 2560 ;
+	int index ;
+	uint8_t zone ;
+
+	for(index = 1 ; index < argc ; index++)
+	{
+		if((0 == strcmp(argv[index], "-t")) && (index + 1 < argc))
+		{
+			seconds = atof(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-c")) && (index + 1 < argc))
+		{
+			celsius = atof(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-s")) && (index + 1 < argc))
+		{
+			g_plant_setpoint = atof(argv[++index]);
+		}
+		else if(0 == strcmp(argv[index], "-p"))
+		{
+			g_plant_enabled = 1 ;
+		}
+		else if(0 == strcmp(argv[index], "-b"))
+		{
+			stalled = 1 ;
+		}
+		else if((0 == strcmp(argv[index], "-n")) && (index + 1 < argc))
+		{
+			noise = atof(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-k")) && (index + 1 < argc))
+		{
+			spike = atof(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-r")) && (index + 1 < argc))
+		{
+			reference = atof(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-e")) && (index + 1 < argc))
+		{
+			g_eeprom_path = argv[++index];
+		}
+		else if((0 == strcmp(argv[index], "-u")) && (index + 1 < argc))
+		{
+			uart_path = argv[++index];
+		}
+		else if((0 == strcmp(argv[index], "-O")) && (index + 1 < argc))
+		{
+			g_check_maxOvershoot = atof(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-S")) && (index + 1 < argc))
+		{
+			g_check_maxSettling = atof(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-D")) && (index + 1 < argc))
+		{
+			g_check_maxDroppedFrames = atol(argv[++index]);
+		}
+		else if((0 == strcmp(argv[index], "-L")) && (index + 1 < argc) && (g_check_lcdTextsCount < CHECK_MAX_LCD_TEXTS))
+		{
+			g_check_lcdTexts[g_check_lcdTextsCount++] = argv[++index];
+		}
+		else
+		{
+			printf("Usage: %s [-t simulated_seconds] [-c lm35_celsius] [-p [-s setpoint_celsius]] [-b] [-n noise_mv] [-k spike_mv] [-r vref_mv] [-e eeprom_file] [-u uart_output]\n", argv[0]);
+			printf("       [-O max_overshoot_celsius] [-S max_settling_seconds] [-D max_dropped_frames] [-L lcd_text]...\n");
+			printf("  -p  closed loop thermal plant of each zone starting at the -c temperature, it reports overshoot and settling time\n");
+			printf("  -b  blocked fan, the tachometer gives no edges\n");
+			printf("  -n  uniform noise on the LM35 inputs, without -p only\n");
+			printf("  -k  random spikes on the LM35 inputs, without -p only\n");
+			printf("  -r  real voltage of the 2.56V internal reference\n");
+			printf("  -e  load the EEPROM from the file and save it back at the end\n");
+			printf("  -u  write the UART bytes to a file or a serial port\n");
+			printf("  -O -S  fail if a plant zone overshoots more or settles later, with -p only\n");
+			printf("  -D  fail if more telemetry frames are dropped\n");
+			printf("  -L  fail if no LCD row shows the text at the end, up to %u texts\n", CHECK_MAX_LCD_TEXTS);
+			return 1 ;
+		}
+	}
+
+	if((!g_plant_enabled) && ((g_check_maxOvershoot >= 0) || (g_check_maxSettling >= 0)))
+	{
+		printf("The overshoot and settling checks need the thermal plant -p\n");
+		return 1 ;
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	Sim_init((uint64_t)(seconds * F_CPU));
+	Sim_setInternalReferenceMillivolts((uint16_t)reference);
+
+	if(g_eeprom_path != NULL)
+	{
+		Eeprom_load();
+		atexit(Eeprom_save);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	/* Sim_finish exits the process, the plant report and the checks follow the simulation report */
+	Sim_setFinishHook(Check_results);
+
+	if(g_plant_enabled)
+	{
+		g_plant_initial = celsius ;
+		for(zone = 0 ; zone < PLANT_NUM_OF_ZONES ; zone++)
+		{
+			g_plant_zones[zone].temperature = celsius ;
+		}
+		Sim_setAdcModel(Plant_adcModel);
+	}
+	else
+	{
+		/* All the sensors are at the same temperature, LM35 gives 10 mV per degree,
+		 * a differential input has its reference pin too */
+		for(zone = 0 ; zone < PLANT_NUM_OF_ZONES ; zone++)
+		{
+			Sim_setAdcInputMillivolts(ADC_INPUT_POSITIVE_PIN(g_plant_channels[zone]), (uint16_t)(celsius * 10));
+			if(ADC_INPUT_IS_DIFFERENTIAL(g_plant_channels[zone]))
+			{
+				Sim_setAdcInputMillivolts(ADC_INPUT_NEGATIVE_PIN(g_plant_channels[zone]), LM35_REFERENCE_MV);
+			}
+			else
+			{
+				/* Do Nothing. */
+			}
+		}
+		Sim_setAdcNoiseMillivolts((uint16_t)noise);
+		Sim_setAdcSpikeMillivolts((uint16_t)spike);
+	}
+
+	if(stalled)
+	{
+		Sim_setTachModel(Fan_stalledTachModel);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	if(uart_path != NULL)
+	{
+		Sim_setUartOutput(Uart_openOutput(uart_path));
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	/* The firmware never returns, the simulation ends at the time limit */
+	App_main();
+	Sim_finish();
+
+	return 0 ;
+}
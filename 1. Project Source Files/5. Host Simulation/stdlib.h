@@ -0,0 +1,26 @@
+/*
+ ============================================================================
+ Name        : stdlib.h
+ Author      : Ahmed Shawky
+ Description : Host Simulation wrapper of <stdlib.h> with the avr-libc extensions
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_STDLIB_H_
+#define SIM_STDLIB_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include_next <stdlib.h>
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* avr-libc integer to string conversion, it is not part of the host C library */
+char *itoa(int value, char *str, int radix);
+
+
+#endif /* SIM_STDLIB_H_ */
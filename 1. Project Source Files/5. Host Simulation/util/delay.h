@@ -0,0 +1,30 @@
+/*
+ ============================================================================
+ Name        : delay.h
+ Author      : Ahmed Shawky
+ Description : Host Simulation replacement of <util/delay.h>
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef SIM_UTIL_DELAY_H_
+#define SIM_UTIL_DELAY_H_
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include "sim.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#ifndef F_CPU
+#define F_CPU 					1000000UL
+#endif
+
+/* The delays advance the simulated time, the interrupts are still served during them */
+#define _delay_ms(ms)			Sim_delayCycles((uint64_t)((double)(ms) * (F_CPU / 1000.0)))
+#define _delay_us(us)			Sim_delayCycles((uint64_t)((double)(us) * (F_CPU / 1000000.0)))
+
+
+#endif /* SIM_UTIL_DELAY_H_ */
@@ -0,0 +1,97 @@
+/*
+ ============================================================================
+ Name        : bench.h
+ Author      : Ahmed Shawky
+ Description : Benchmarks list shared by the benchmark firmware and the simavr runner
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+
+/* The firmware writes the markers to TWAR, TWI is not used by the project */
+#define BENCH_MARKER_IO_ADDRESS			0x02
+
+/* Marker values, the other values start the benchmark with the same id.
+ * After the load marker the application runs with the interrupts enabled until the runner stops it. */
+#define BENCH_STOP_ID					0xFE
+#define BENCH_LOAD_ID					0xFF
+
+/* Duration of the application run, the runner measures each ISR and the CPU load during it */
+#define BENCH_LOAD_MS					2000
+
+/* Fan tach signal on ICP1 (PD6) during the application run, 3000 RPM with 2 pulses per revolution */
+#define BENCH_TACH_HZ					100
+
+/* Number of runs of each benchmark, the runner reports the minimum, maximum and average cycles */
+#define BENCH_REPEAT					16
+
+/* LM35 input applied by the runner, 45 C on ADC2 */
+#define BENCH_SENSOR_CHANNEL			2
+#define BENCH_SENSOR_MV					450
+
+/* The firmware is also built without the floating point LM35 baseline,
+ * the runner reports the flash difference as the soft-float cost */
+#ifndef BENCH_FLOAT_BASELINE
+#define BENCH_FLOAT_BASELINE			1
+#endif
+
+/* BENCH(id, name): the empty benchmark must be the first one, its cycles are the markers overhead */
+#define BENCH_LIST(BENCH) \
+	BENCH(BENCH_EMPTY,                  "empty") \
+	BENCH(BENCH_LM35_POLLING,           "LM35_GetTemperature_polling") \
+	BENCH(BENCH_ADC_OVERSAMPLED_POLLING, "ADC_readOversampled_polling") \
+	BENCH(BENCH_LM35_TEMPERATURE,       "LM35_GetTemperature") \
+	BENCH(BENCH_LM35_TEMPERATURE_DC,    "LM35_GetTemperature_dC") \
+	BENCH(BENCH_LM35_FLOAT,             "LM35_GetTemperature_float") \
+	BENCH(BENCH_DC_MOTOR_ROTATE,        "DcMotor_Rotate") \
+	BENCH(BENCH_DC_MOTOR_ROTATE_SAME,   "DcMotor_Rotate_unchanged") \
+	BENCH(BENCH_FAN_GET_RPM,            "Fan_GetRPM") \
+	BENCH(BENCH_FILTER_UPDATE,          "Filter_update") \
+	BENCH(BENCH_LCD_INTEGER_TO_STRING,  "LCD_integerToString") \
+	BENCH(BENCH_LCD_FLUSH,              "LCD_flush") \
+	BENCH(BENCH_APP_SENSOR_TASK,        "App_sensorTask") \
+	BENCH(BENCH_APP_CONTROL_TASK,       "App_controlTask") \
+	BENCH(BENCH_APP_DISPLAY_TASK,       "App_displayTask")
+
+#define BENCH_ENUM(id, name)			id,
+#define BENCH_NAME(id, name)			name,
+
+/* BENCH_ISR(id, vector, name): the ISRs of the project with their ATmega32 vector numbers,
+ * the runner times each one from its vector entry to its reti */
+#define BENCH_ISR_LIST(BENCH_ISR) \
+	BENCH_ISR(BENCH_ISR_TIMER1_CAPT,    6,  "TIMER1_CAPT_vect") \
+	BENCH_ISR(BENCH_ISR_TIMER1_COMPA,   7,  "TIMER1_COMPA_vect") \
+	BENCH_ISR(BENCH_ISR_TIMER1_COMPB,   8,  "TIMER1_COMPB_vect") \
+	BENCH_ISR(BENCH_ISR_TIMER1_OVF,     9,  "TIMER1_OVF_vect") \
+	BENCH_ISR(BENCH_ISR_USART_RXC,      13, "USART_RXC_vect") \
+	BENCH_ISR(BENCH_ISR_USART_UDRE,     14, "USART_UDRE_vect") \
+	BENCH_ISR(BENCH_ISR_ADC,            16, "ADC_vect") \
+	BENCH_ISR(BENCH_ISR_EE_RDY,         17, "EE_RDY_vect")
+
+#define BENCH_ISR_ENUM(id, vector, name)	id,
+#define BENCH_ISR_VECTOR(id, vector, name)	vector,
+#define BENCH_ISR_NAME(id, vector, name)	name,
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef enum
+{
+	BENCH_LIST(BENCH_ENUM)
+	BENCH_COUNT
+}Bench_IdType;
+
+typedef enum
+{
+	BENCH_ISR_LIST(BENCH_ISR_ENUM)
+	BENCH_ISR_COUNT
+}Bench_IsrIdType;
+
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,166 @@
+/*
+ ============================================================================
+ Name        : bench_main.c
+ Author      : Ahmed Shawky
+ Description : Benchmark firmware, it runs the drivers hot paths between cycle markers
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+#include "bench.h"
+#include "lcd.h"
+#include "lm35_sensor.h"
+#include "dc_motor.h"
+#include "fan_tach.h"
+#include "adc.h"
+#include "sensor_filter.h"
+#include "scheduler.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#define BENCH_MARKER					TWAR
+
+#if (BENCH_SENSOR_CHANNEL != SENSOR_CHANNEL_ID)
+#error "BENCH_SENSOR_CHANNEL should be the channel of the first LM35 sensor"
+#endif
+
+/* Floating point constants of the LM35 conversion before the fixed point scale factors */
+#define BENCH_ADC_REF_VOLT_VALUE		2.56
+#define BENCH_SENSOR_MAX_VOLT_VALUE		1.5
+
+/* Run the statement BENCH_REPEAT times between a start and a stop marker,
+ * the setup is not measured and both can use the run index.
+ * The statement runs with the interrupts disabled, so the ADC and the scheduler tick
+ * interrupts are not counted in its cycles, they are served after the stop marker.
+ * The ISRs are measured by the runner in the load phase at the end. */
+#define BENCH_RUN(id, setup, statement) \
+	do \
+	{ \
+		uint8 run ; \
+		uint8 sreg ; \
+		for(run = 0 ; run < BENCH_REPEAT ; run++) \
+		{ \
+			setup ; \
+			sreg = SREG ; \
+			cli(); \
+			BENCH_MARKER = (id) ; \
+			statement ; \
+			BENCH_MARKER = BENCH_STOP_ID ; \
+			SREG = sreg ; \
+		} \
+	}while(0)
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+
+/* The results are stored here, so the measured calls are not optimized away */
+static volatile uint16 g_bench_sink ;
+
+/* Full median window, the worst case moves the free slot over the whole window */
+static Filter_StateType g_bench_filter ;
+
+/****************************************************************************
+ * 							Functions Prototypes						    *
+ ****************************************************************************/
+
+/* Application.c is built with its main renamed, the benchmarks call its tasks directly */
+void App_init(void);
+void App_sensorTask(void);
+void App_controlTask(void);
+void App_displayTask(void);
+
+#if (BENCH_FLOAT_BASELINE)
+static uint8 Bench_LM35_GetTemperatureFloat(void);
+#endif
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+int main(void)
+{
+	ADC_ConfigType adc_config ;
+
+	adc_config.ref_volt = INTERNAL_VOLTAGE ;
+	adc_config.prescaler = ADC_PRESCALER_AUTO ;
+	adc_config.mode = ADC_POLLING_MODE ;
+	adc_config.channels_mask = LM35_CHANNELS_MASK ;
+	adc_config.scan_list = NULL_PTR ;
+	adc_config.scan_length = 0 ;
+	adc_config.trigger_source = ADC_TRIGGER_FREE_RUNNING ;
+
+	g_bench_filter.ema_shift = 2 ;
+	Filter_reset(&g_bench_filter);
+
+	BENCH_RUN(BENCH_EMPTY, , );
+
+	/* Polling mode, each read waits for a whole conversion */
+	ADC_init(&adc_config);
+	BENCH_RUN(BENCH_LM35_POLLING, , g_bench_sink = LM35_GetTemperature(0));
+	BENCH_RUN(BENCH_ADC_OVERSAMPLED_POLLING, , g_bench_sink = ADC_readOversampled(BENCH_SENSOR_CHANNEL, LM35_OVERSAMPLING_BITS));
+
+	/* The application configuration, Timer0 triggered ADC scan, scheduler tick and interrupts enabled.
+	 * The wait fills the oversampling history, 16 scans of two conversions each 2 ms */
+	App_init();
+	_delay_ms(80);
+
+	BENCH_RUN(BENCH_LM35_TEMPERATURE, , g_bench_sink = LM35_GetTemperature(0));
+	BENCH_RUN(BENCH_LM35_TEMPERATURE_DC, , g_bench_sink = LM35_GetTemperature_dC(0));
+#if (BENCH_FLOAT_BASELINE)
+	BENCH_RUN(BENCH_LM35_FLOAT, , g_bench_sink = Bench_LM35_GetTemperatureFloat());
+#endif
+
+	/* Change the speed in each run, then repeat the same speed */
+	BENCH_RUN(BENCH_DC_MOTOR_ROTATE, , DcMotor_Rotate(0, MOTOR_CW, (run & 0x03) * 25));
+	BENCH_RUN(BENCH_DC_MOTOR_ROTATE_SAME, , DcMotor_Rotate(0, MOTOR_CW, 50));
+
+	/* No tach edges in the simulator, it measures the stall check with the extended Timer1 read */
+	BENCH_RUN(BENCH_FAN_GET_RPM, , g_bench_sink = Fan_GetRPM());
+
+	/* Samples jump between the two ends of the window */
+	BENCH_RUN(BENCH_FILTER_UPDATE, , g_bench_sink = Filter_update(&g_bench_filter, (run & 1) ? 1000 : 0));
+
+	/* A three digits number, then send it to the LCD after the previous transfers are finished */
+	BENCH_RUN(BENCH_LCD_INTEGER_TO_STRING, LCD_moveCursor(1, 11), LCD_integerToString(100 + run));
+	BENCH_RUN(BENCH_LCD_FLUSH, (_delay_ms(5), LCD_moveCursor(1, 11), LCD_integerToString(200 + run)), LCD_flush());
+
+	/* The scheduler tasks, the first display run redraws the temperature and the next runs find the screen unchanged */
+	BENCH_RUN(BENCH_APP_SENSOR_TASK, , App_sensorTask());
+	BENCH_RUN(BENCH_APP_CONTROL_TASK, , App_controlTask());
+	BENCH_RUN(BENCH_APP_DISPLAY_TASK, _delay_ms(5), App_displayTask());
+
+	/* Load phase: the application tasks run by the scheduler with all the interrupts, it never returns.
+	 * The runner times each ISR and the CPU sleep for BENCH_LOAD_MS, then it stops the simulation */
+	BENCH_MARKER = BENCH_LOAD_ID ;
+	Scheduler_run();
+
+	return 0 ;
+}
+
+#if (BENCH_FLOAT_BASELINE)
+/* Inputs: void.
+ *
+ * Return Value: Temperature value from the first LM35 sensor.
+ *
+ * Description:
+ *	The LM35 conversion with the double constants, as it was before the fixed point scale factors.
+ *	It is kept only as the baseline of LM35_GetTemperature, it pulls in the soft-float library.
+ */
+static uint8 Bench_LM35_GetTemperatureFloat(void)
+{
+	uint8 temp_value = 0 ;
+
+	uint16 adc_value = ADC_readChannel(SENSOR_CHANNEL_ID) ;
+
+	temp_value = (uint8)(((uint32)adc_value*SENSOR_MAX_TEMP_VALUE*BENCH_ADC_REF_VOLT_VALUE)/(ADC_MAXIMUM_VALUE*BENCH_SENSOR_MAX_VOLT_VALUE));
+
+	return temp_value ;
+}
+#endif
@@ -0,0 +1,384 @@
+/*
+ ============================================================================
+ Name        : bench_runner.c
+ Author      : Ahmed Shawky
+ Description : Runs the benchmark firmware under simavr and prints the results as JSON
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+#include "sim_interrupts.h"
+#include "sim_cycle_timers.h"
+#include "avr_adc.h"
+#include "avr_ioport.h"
+#include "bench.h"
+
+/****************************************************************************
+ * 								 Definitions								*
+ ****************************************************************************/
+#ifndef F_CPU
+#define F_CPU 						1000000UL
+#endif
+
+#define BENCH_MCU					"atmega32"
+
+/* simavr data space address of the marker register */
+#define BENCH_MARKER_ADDRESS		(BENCH_MARKER_IO_ADDRESS + 0x20)
+
+/* The firmware is stopped if it does not finish in 60 seconds of simulated time */
+#define BENCH_CYCLE_LIMIT			(60ULL * F_CPU)
+
+#define BENCH_NO_RUN				0xFF
+
+/* Length of the load phase in cycles */
+#define BENCH_LOAD_CYCLES			((uint64_t)BENCH_LOAD_MS * F_CPU / 1000)
+
+/* Half period of the tach signal in cycles, the ICP1 pin is toggled after each one */
+#define BENCH_TACH_HALF_CYCLES		(F_CPU / (2 * BENCH_TACH_HZ))
+
+/****************************************************************************
+ * 							  Types Declaration							    *
+ ****************************************************************************/
+typedef struct
+{
+	uint32_t runs ;
+	uint64_t min_cycles ;
+	uint64_t max_cycles ;
+	uint64_t total_cycles ;
+	uint64_t budget_cycles ;	/* 0 when the benchmark has no budget */
+}Bench_ResultType;
+
+typedef struct
+{
+	Bench_ResultType result ;
+	avr_cycle_count_t entry ;	/* cycle of the vector entry, 0 when the ISR is not running */
+}Bench_IsrType;
+
+/****************************************************************************
+ * 							  Global Variables							    *
+ ****************************************************************************/
+static const char *g_bench_names[BENCH_COUNT] = { BENCH_LIST(BENCH_NAME) } ;
+static Bench_ResultType g_bench_results[BENCH_COUNT] ;
+static uint8_t g_bench_current = BENCH_NO_RUN ;
+static avr_cycle_count_t g_bench_start = 0 ;
+static int g_bench_done = 0 ;
+static avr_t *g_bench_avr = NULL ;
+
+/* Load phase: the ISRs timing, the sleep cycles and the phase start, 0 before the load marker */
+static const uint8_t g_bench_isrVectors[BENCH_ISR_COUNT] = { BENCH_ISR_LIST(BENCH_ISR_VECTOR) } ;
+static const char *g_bench_isrNames[BENCH_ISR_COUNT] = { BENCH_ISR_LIST(BENCH_ISR_NAME) } ;
+static Bench_IsrType g_bench_isrs[BENCH_ISR_COUNT] ;
+static avr_cycle_count_t g_bench_loadStart = 0 ;
+static uint64_t g_bench_sleepCycles = 0 ;
+static double g_bench_loadBudget = 0 ;
+static void (*g_bench_sleep)(struct avr_t *avr, avr_cycle_count_t how_long) = NULL ;
+static uint32_t g_bench_tachLevel = 0 ;
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Add one measurement to a result */
+static void Bench_addCycles(Bench_ResultType *result, uint64_t cycles)
+{
+	result->min_cycles = ((0 == result->runs) || (cycles < result->min_cycles)) ? cycles : result->min_cycles ;
+	result->max_cycles = (cycles > result->max_cycles) ? cycles : result->max_cycles ;
+	result->total_cycles += cycles ;
+	result->runs++ ;
+}
+
+/* simavr cycle timer of the load phase, it toggles the ICP1 pin so the fan tach capture interrupt runs */
+static avr_cycle_count_t Bench_tachToggle(struct avr_t *avr, avr_cycle_count_t when, void *param)
+{
+	(void)param ;
+
+	g_bench_tachLevel ^= 1 ;
+	avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 6), g_bench_tachLevel);
+
+	return when + BENCH_TACH_HALF_CYCLES ;
+}
+
+/* Called by simavr when the firmware writes a marker, the cycles between
+ * the start and the stop markers are added to the running benchmark */
+static void Bench_markerWrite(struct avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param)
+{
+	uint64_t cycles ;
+
+	(void)addr ;
+	(void)param ;
+
+	if(BENCH_LOAD_ID == value)
+	{
+		g_bench_loadStart = avr->cycle ;
+		avr_cycle_timer_register(avr, BENCH_TACH_HALF_CYCLES, Bench_tachToggle, NULL);
+	}
+	else if(BENCH_STOP_ID == value)
+	{
+		if(g_bench_current < BENCH_COUNT)
+		{
+			cycles = avr->cycle - g_bench_start ;
+			Bench_addCycles(&g_bench_results[g_bench_current], cycles);
+		}
+		g_bench_current = BENCH_NO_RUN ;
+	}
+	else
+	{
+		g_bench_current = value ;
+		g_bench_start = avr->cycle ;
+	}
+}
+
+/* Called by simavr when an interrupt vector is entered (value 1) and at its reti (value 0),
+ * the cycles of each call in the load phase are added to the ISR */
+static void Bench_isrRunning(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	Bench_IsrType *isr = (Bench_IsrType *)param ;
+
+	(void)irq ;
+
+	if(0 == g_bench_loadStart)
+	{
+		/* Do Nothing. */
+	}
+	else if(value != 0)
+	{
+		isr->entry = g_bench_avr->cycle ;
+	}
+	else if(isr->entry != 0)
+	{
+		Bench_addCycles(&isr->result, g_bench_avr->cycle - isr->entry);
+		isr->entry = 0 ;
+	}
+}
+
+/* Called by simavr instead of its sleep function, the sleep cycles of the load phase are counted.
+ * simavr adds one more cycle after the sleep. */
+static void Bench_sleep(struct avr_t *avr, avr_cycle_count_t how_long)
+{
+	if(g_bench_loadStart != 0)
+	{
+		g_bench_sleepCycles += how_long + 1 ;
+	}
+	g_bench_sleep(avr, how_long);
+}
+
+/* Parse "name=cycles" and set the budget of the benchmark or the ISR */
+static int Bench_setBudget(const char *argument)
+{
+	const char *separator = strchr(argument, '=') ;
+	int index ;
+
+	if(separator != NULL)
+	{
+		for(index = 0 ; index < BENCH_COUNT ; index++)
+		{
+			if((strlen(g_bench_names[index]) == (size_t)(separator - argument)) &&
+			   (0 == strncmp(g_bench_names[index], argument, separator - argument)))
+			{
+				g_bench_results[index].budget_cycles = strtoull(separator + 1, NULL, 10);
+				return 0 ;
+			}
+		}
+		for(index = 0 ; index < BENCH_ISR_COUNT ; index++)
+		{
+			if((strlen(g_bench_isrNames[index]) == (size_t)(separator - argument)) &&
+			   (0 == strncmp(g_bench_isrNames[index], argument, separator - argument)))
+			{
+				g_bench_isrs[index].result.budget_cycles = strtoull(separator + 1, NULL, 10);
+				return 0 ;
+			}
+		}
+	}
+
+	fprintf(stderr, "bench_runner: unknown budget '%s'\n", argument);
+	return -1 ;
+}
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+int main(int argc, char *argv[])
+{
+	elf_firmware_t firmware ;
+	elf_firmware_t no_float_firmware ;
+	avr_t *avr ;
+	const char *elf_path = NULL ;
+	const char *no_float_path = NULL ;
+	uint64_t overhead ;
+	uint64_t measured ;
+	uint64_t load_cycles ;
+	uint64_t isr_cycles = 0 ;
+	double cpu_percent ;
+	avr_irq_t *irq ;
+	int over_budget = 0 ;
+	int state = cpu_Running ;
+	int index ;
+
+	for(index = 1 ; index < argc ; index++)
+	{
+		if((0 == strcmp(argv[index], "-b")) && (index + 1 < argc))
+		{
+			if(Bench_setBudget(argv[++index]) != 0)
+			{
+				return 1 ;
+			}
+		}
+		else if((0 == strcmp(argv[index], "-f")) && (index + 1 < argc))
+		{
+			no_float_path = argv[++index] ;
+		}
+		else if((0 == strcmp(argv[index], "-l")) && (index + 1 < argc))
+		{
+			g_bench_loadBudget = atof(argv[++index]);
+		}
+		else
+		{
+			elf_path = argv[index] ;
+		}
+	}
+
+	if(NULL == elf_path)
+	{
+		fprintf(stderr, "Usage: %s [-b benchmark_or_isr=max_cycles]... [-l max_cpu_percent] [-f bench_no_float.elf] bench.elf\n", argv[0]);
+		return 1 ;
+	}
+
+	memset(&firmware, 0, sizeof(firmware));
+	if(elf_read_firmware(elf_path, &firmware) != 0)
+	{
+		fprintf(stderr, "bench_runner: can not read %s\n", elf_path);
+		return 1 ;
+	}
+
+	/* The same firmware without the floating point baseline, only its size is used */
+	memset(&no_float_firmware, 0, sizeof(no_float_firmware));
+	if((no_float_path != NULL) && (elf_read_firmware(no_float_path, &no_float_firmware) != 0))
+	{
+		fprintf(stderr, "bench_runner: can not read %s\n", no_float_path);
+		return 1 ;
+	}
+
+	strcpy(firmware.mmcu, BENCH_MCU);
+	firmware.frequency = F_CPU ;
+	firmware.vcc = 5000 ;
+	firmware.avcc = 5000 ;
+	firmware.aref = 5000 ;
+
+	avr = avr_make_mcu_by_name(firmware.mmcu);
+	if(NULL == avr)
+	{
+		fprintf(stderr, "bench_runner: simavr does not support %s\n", firmware.mmcu);
+		return 1 ;
+	}
+	avr_init(avr);
+	g_bench_avr = avr ;
+	avr_load_firmware(avr, &firmware);
+
+	avr_register_io_write(avr, BENCH_MARKER_ADDRESS, Bench_markerWrite, NULL);
+	avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_ADC0 + BENCH_SENSOR_CHANNEL), BENCH_SENSOR_MV);
+
+	/* The vector entry and exit markers of simavr, the ISRs have no code for the benchmark */
+	for(index = 0 ; index < BENCH_ISR_COUNT ; index++)
+	{
+		irq = avr_get_interrupt_irq(avr, g_bench_isrVectors[index]);
+		if(irq != NULL)
+		{
+			avr_irq_register_notify(irq + AVR_INT_IRQ_RUNNING, Bench_isrRunning, &g_bench_isrs[index]);
+		}
+	}
+	g_bench_sleep = avr->sleep ;
+	avr->sleep = Bench_sleep ;
+
+	while((0 == g_bench_done) && (state != cpu_Done) && (state != cpu_Crashed) && (avr->cycle < BENCH_CYCLE_LIMIT))
+	{
+		state = avr_run(avr);
+		g_bench_done = (g_bench_loadStart != 0) && (avr->cycle >= (g_bench_loadStart + BENCH_LOAD_CYCLES)) ;
+	}
+	load_cycles = (g_bench_loadStart != 0) ? (avr->cycle - g_bench_loadStart) : 0 ;
+
+	/* The markers cost is measured by the empty benchmark and removed from the others */
+	overhead = g_bench_results[BENCH_EMPTY].min_cycles ;
+
+	printf("{\n");
+	printf("  \"mcu\": \"%s\",\n", BENCH_MCU);
+	printf("  \"f_cpu\": %lu,\n", (unsigned long)F_CPU);
+	printf("  \"complete\": %s,\n", g_bench_done ? "true" : "false");
+	printf("  \"footprint\": {\"flash\": %u, \"data\": %u, \"bss\": %u, \"sram\": %u},\n",
+			(unsigned)firmware.flashsize, (unsigned)firmware.datasize, (unsigned)firmware.bsssize,
+			(unsigned)(firmware.datasize + firmware.bsssize));
+	if(no_float_path != NULL)
+	{
+		printf("  \"float_baseline_flash\": %d,\n", (int)firmware.flashsize - (int)no_float_firmware.flashsize);
+	}
+	printf("  \"marker_overhead_cycles\": %llu,\n", (unsigned long long)overhead);
+	printf("  \"benchmarks\": [\n");
+	for(index = 1 ; index < BENCH_COUNT ; index++)
+	{
+		Bench_ResultType *result = &g_bench_results[index] ;
+		uint64_t min_cycles = (result->min_cycles > overhead) ? (result->min_cycles - overhead) : 0 ;
+		uint64_t max_cycles = (result->max_cycles > overhead) ? (result->max_cycles - overhead) : 0 ;
+		uint64_t avg_cycles = (result->runs != 0) ? (result->total_cycles / result->runs) : 0 ;
+
+		avg_cycles = (avg_cycles > overhead) ? (avg_cycles - overhead) : 0 ;
+		measured = max_cycles ;
+		printf("    {\"name\": \"%s\", \"runs\": %u, \"min_cycles\": %llu, \"max_cycles\": %llu, \"avg_cycles\": %llu, \"max_us\": %.1f",
+				g_bench_names[index], (unsigned)result->runs, (unsigned long long)min_cycles,
+				(unsigned long long)max_cycles, (unsigned long long)avg_cycles, measured * 1e6 / F_CPU);
+		if(result->budget_cycles != 0)
+		{
+			printf(", \"budget_cycles\": %llu, \"within_budget\": %s",
+					(unsigned long long)result->budget_cycles, (measured <= result->budget_cycles) ? "true" : "false");
+			over_budget |= (measured > result->budget_cycles) ;
+		}
+		printf("}%s\n", (index + 1 < BENCH_COUNT) ? "," : "");
+	}
+	printf("  ],\n");
+
+	/* Load phase: the cost of each ISR and how much of the CPU the application uses with all the interrupts */
+	printf("  \"interrupts\": [\n");
+	for(index = 0 ; index < BENCH_ISR_COUNT ; index++)
+	{
+		Bench_ResultType *result = &g_bench_isrs[index].result ;
+		uint64_t avg_cycles = (result->runs != 0) ? (result->total_cycles / result->runs) : 0 ;
+
+		isr_cycles += result->total_cycles ;
+		printf("    {\"name\": \"%s\", \"calls\": %u, \"calls_per_s\": %.1f, \"min_cycles\": %llu, \"max_cycles\": %llu, \"avg_cycles\": %llu, \"cpu_percent\": %.2f",
+				g_bench_isrNames[index], (unsigned)result->runs,
+				(load_cycles != 0) ? (result->runs * (double)F_CPU / load_cycles) : 0.0,
+				(unsigned long long)result->min_cycles, (unsigned long long)result->max_cycles, (unsigned long long)avg_cycles,
+				(load_cycles != 0) ? (result->total_cycles * 100.0 / load_cycles) : 0.0);
+		if(result->budget_cycles != 0)
+		{
+			printf(", \"budget_cycles\": %llu, \"within_budget\": %s",
+					(unsigned long long)result->budget_cycles, (result->max_cycles <= result->budget_cycles) ? "true" : "false");
+			over_budget |= (result->max_cycles > result->budget_cycles) ;
+		}
+		printf("}%s\n", (index + 1 < BENCH_ISR_COUNT) ? "," : "");
+	}
+	printf("  ],\n");
+
+	/* The CPU is busy when it does not sleep: the ISRs, the tasks and the scheduler loop */
+	cpu_percent = (load_cycles != 0) ? ((load_cycles - g_bench_sleepCycles) * 100.0 / load_cycles) : 0.0 ;
+	printf("  \"load\": {\"cycles\": %llu, \"cpu_percent\": %.2f, \"isr_percent\": %.2f",
+			(unsigned long long)load_cycles, cpu_percent, (load_cycles != 0) ? (isr_cycles * 100.0 / load_cycles) : 0.0);
+	if(g_bench_loadBudget != 0)
+	{
+		printf(", \"budget_percent\": %.1f, \"within_budget\": %s", g_bench_loadBudget, (cpu_percent <= g_bench_loadBudget) ? "true" : "false");
+		over_budget |= (cpu_percent > g_bench_loadBudget) ;
+	}
+	printf("}\n");
+	printf("}\n");
+
+	/* A timing regression or an unfinished run fails the benchmark target */
+	return (g_bench_done && !over_budget) ? 0 : 2 ;
+}
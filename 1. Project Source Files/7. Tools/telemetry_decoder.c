@@ -0,0 +1,157 @@
+/*
+ ============================================================================
+ Name        : telemetry_decoder.c
+ Author      : Ahmed Shawky
+ Description : Host decoder of the binary telemetry stream, it prints the frames as CSV
+ Date        : 17/10/2026
+ ============================================================================
+ */
+
+/****************************************************************************
+ * 								  Includes								    *
+ ****************************************************************************/
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "std_types.h"
+#include "crc16.h"
+#include "telemetry.h"
+
+/****************************************************************************
+ * 						Private Functions Definitions					    *
+ ****************************************************************************/
+
+/* Read the little endian 16-bit field of the frame */
+static uint16 Decoder_getWord(const uint8 *frame_ptr)
+{
+	return (uint16)(frame_ptr[0] | (frame_ptr[1] << 8)) ;
+}
+
+/* Set a serial port to raw mode with the telemetry baud rate, the files are not changed */
+static void Decoder_setupInput(int fd)
+{
+	struct termios settings ;
+
+	if(isatty(fd) && (0 == tcgetattr(fd, &settings)))
+	{
+		cfmakeraw(&settings);
+		cfsetispeed(&settings, B9600);
+		cfsetospeed(&settings, B9600);
+		tcsetattr(fd, TCSANOW, &settings);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+}
+
+static void Decoder_printFrame(const uint8 *frame_ptr)
+{
+	uint32 timestamp_ms = Decoder_getWord(&frame_ptr[TELEMETRY_TIMESTAMP_OFFSET]) |
+							((uint32)Decoder_getWord(&frame_ptr[TELEMETRY_TIMESTAMP_OFFSET + 2]) << 16) ;
+	uint16 temperature_dC = Decoder_getWord(&frame_ptr[TELEMETRY_TEMPERATURE_OFFSET]) ;
+	uint16 rpm = Decoder_getWord(&frame_ptr[TELEMETRY_RPM_OFFSET]) ;
+
+	printf("%lu,%u,%u,%u.%u,%u,", (unsigned long)timestamp_ms, frame_ptr[TELEMETRY_ZONE_OFFSET],
+			Decoder_getWord(&frame_ptr[TELEMETRY_ADC_OFFSET]), temperature_dC / 10, temperature_dC % 10,
+			frame_ptr[TELEMETRY_DUTY_OFFSET]);
+	if(TELEMETRY_NO_RPM == rpm)
+	{
+		printf("\n");
+	}
+	else
+	{
+		printf("%u\n", rpm);
+	}
+}
+
+/****************************************************************************
+ * 							Functions Definitions						    *
+ ****************************************************************************/
+
+/* Usage: telemetry_decoder [file or serial port], the standard input is read without argument.
+ * The stream is searched for the sync bytes, a frame with a wrong CRC is skipped by one byte
+ * so the decoder locks again on the next real frame. */
+int main(int argc, char *argv[])
+{
+	uint8 frame[TELEMETRY_FRAME_SIZE] ;
+	uint8 length = 0 ;
+	uint8 index ;
+	unsigned long bad_frames = 0 ;
+	int fd = STDIN_FILENO ;
+
+	if(argc > 2)
+	{
+		fprintf(stderr, "Usage: %s [file or serial port]\n", argv[0]);
+		return 1 ;
+	}
+	else if(2 == argc)
+	{
+		fd = open(argv[1], O_RDONLY | O_NOCTTY) ;
+		if(fd < 0)
+		{
+			perror(argv[1]);
+			return 1 ;
+		}
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	Decoder_setupInput(fd);
+	printf("time_ms,zone,adc,temperature_c,duty,rpm\n");
+
+	while(read(fd, &frame[length], 1) == 1)
+	{
+		length++ ;
+
+		/* Keep only the bytes which may start a frame */
+		if(((1 == length) && (frame[0] != TELEMETRY_SYNC_BYTE1)) ||
+		   ((2 == length) && (frame[1] != TELEMETRY_SYNC_BYTE2)))
+		{
+			length = (TELEMETRY_SYNC_BYTE1 == frame[length - 1]) ? 1 : 0 ;
+			frame[0] = TELEMETRY_SYNC_BYTE1 ;
+		}
+		else if(TELEMETRY_FRAME_SIZE == length)
+		{
+			if(CRC16_compute(&frame[TELEMETRY_ZONE_OFFSET], TELEMETRY_CRC_OFFSET - TELEMETRY_ZONE_OFFSET) ==
+			   Decoder_getWord(&frame[TELEMETRY_CRC_OFFSET]))
+			{
+				Decoder_printFrame(frame);
+				length = 0 ;
+			}
+			else
+			{
+				/* Search for the next sync in the received bytes */
+				bad_frames++ ;
+				for(index = 1 ; (index < TELEMETRY_FRAME_SIZE) && (frame[index] != TELEMETRY_SYNC_BYTE1) ; index++)
+				{
+					/* Do Nothing. */
+				}
+				length = TELEMETRY_FRAME_SIZE - index ;
+				for(index = 0 ; index < length ; index++)
+				{
+					frame[index] = frame[TELEMETRY_FRAME_SIZE - length + index] ;
+				}
+			}
+		}
+		else
+		{
+			/* Do Nothing. */
+		}
+		fflush(stdout);
+	}
+
+	if(bad_frames != 0)
+	{
+		fprintf(stderr, "%lu frames with wrong CRC\n", bad_frames);
+	}
+	else
+	{
+		/* Do Nothing. */
+	}
+
+	return 0 ;
+}